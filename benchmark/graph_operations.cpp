@@ -0,0 +1,86 @@
+// single operations of gdwg::graph<int, int> on R-MAT graphs of 2^scale nodes and 16 edges per
+// node, with the hardware counters of each operation (see perf_counters.hpp). The queried
+// endpoints are R-MAT edges as well, so the accesses are as skewed as the graph itself.
+#include "perf_counters.hpp"
+
+#include <benchmark/benchmark.h>
+#include <cstddef>
+#include <cstdint>
+#include <gdwg/generate.hpp>
+#include <gdwg/graph.hpp>
+#include <vector>
+
+namespace {
+	using graph = gdwg::graph<int, int>;
+
+	auto edges_of(benchmark::State const& state, std::uint64_t seed) {
+		return gdwg::generate::rmat<int, int>(
+		   {.scale = static_cast<unsigned>(state.range(0)), .edge_factor = 16, .seed = seed});
+	}
+
+	auto build(benchmark::State const& state) -> graph {
+		auto const edges = edges_of(state, 6771);
+		auto g = graph(edges.begin(), edges.end());
+		// the queries may name nodes without any edge in g
+		for (auto node = 0; node < (1 << state.range(0)); ++node) {
+			g.insert_node(node);
+		}
+		return g;
+	}
+
+	// runs op(g, edge) on the edges of another R-MAT stream, round robin
+	template<typename F>
+	auto run(benchmark::State& state, F op) -> void {
+		auto g = build(state);
+		auto const queries = edges_of(state, 42);
+		auto counters = perf_counters{};
+		auto i = std::size_t{0};
+		counters.start();
+		for (auto _ : state) {
+			op(g, queries[i]);
+			i = i + 1 == queries.size() ? 0 : i + 1;
+		}
+		counters.stop();
+		counters.report(state);
+		state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations()));
+	}
+
+	auto is_connected(benchmark::State& state) -> void {
+		run(state, [](graph const& g, auto const& e) {
+			benchmark::DoNotOptimize(g.is_connected(e.from, e.to));
+		});
+	}
+
+	auto weights(benchmark::State& state) -> void {
+		run(state, [](graph const& g, auto const& e) {
+			benchmark::DoNotOptimize(g.weights(e.from, e.to));
+		});
+	}
+
+	auto connections(benchmark::State& state) -> void {
+		run(state, [](graph const& g, auto const& e) {
+			benchmark::DoNotOptimize(g.connections(e.from));
+		});
+	}
+
+	auto find(benchmark::State& state) -> void {
+		run(state, [](graph const& g, auto const& e) {
+			benchmark::DoNotOptimize(g.find(e.from, e.to, e.weight));
+		});
+	}
+
+	// every edge inserted is erased again ==> the graph doesn't grow with the iterations
+	auto insert_erase_edge(benchmark::State& state) -> void {
+		run(state, [](graph& g, auto const& e) {
+			if (g.insert_edge(e.from, e.to, e.weight + 1000)) {
+				g.erase_edge(e.from, e.to, e.weight + 1000);
+			}
+		});
+	}
+} // namespace
+
+BENCHMARK(is_connected)->DenseRange(10, 16, 3);
+BENCHMARK(weights)->DenseRange(10, 16, 3);
+BENCHMARK(connections)->DenseRange(10, 16, 3);
+BENCHMARK(find)->DenseRange(10, 16, 3);
+BENCHMARK(insert_erase_edge)->DenseRange(10, 16, 3);
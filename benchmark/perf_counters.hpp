@@ -0,0 +1,128 @@
+#ifndef GDWG_BENCHMARK_PERF_COUNTERS_HPP
+#define GDWG_BENCHMARK_PERF_COUNTERS_HPP
+
+#include <array>
+#include <benchmark/benchmark.h>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+// hardware counters of the calling thread around a benchmark loop, via perf_event_open:
+//     auto counters = perf_counters{};
+//     counters.start();
+//     for (auto _ : state) { ... }
+//     counters.stop();
+//     counters.report(state);
+// adds cycles, instructions, cache-misses and branch-misses per iteration to the counters of the
+// benchmark. The four events are one group, scheduled together, and scaled if the kernel had to
+// multiplex them. Where perf events are not available (not Linux, perf_event_paranoid, containers)
+// nothing is counted and the benchmark is labelled "no perf counters".
+class perf_counters {
+public:
+	static constexpr auto names =
+	   std::array<std::string_view, 4>{"cycles", "instructions", "cache-misses", "branch-misses"};
+
+	perf_counters() {
+#ifdef __linux__
+		constexpr auto configs = std::array<std::uint64_t, 4>{PERF_COUNT_HW_CPU_CYCLES,
+		                                                      PERF_COUNT_HW_INSTRUCTIONS,
+		                                                      PERF_COUNT_HW_CACHE_MISSES,
+		                                                      PERF_COUNT_HW_BRANCH_MISSES};
+		for (auto i = std::size_t{0}; i < configs.size(); ++i) {
+			auto attr = perf_event_attr{};
+			attr.type = PERF_TYPE_HARDWARE;
+			attr.size = sizeof(attr);
+			attr.config = configs[i];
+			attr.disabled = i == 0 ? 1 : 0; // the whole group follows its leader
+			attr.exclude_kernel = 1;
+			attr.exclude_hv = 1;
+			attr.read_format = PERF_FORMAT_GROUP | PERF_FORMAT_TOTAL_TIME_ENABLED
+			                   | PERF_FORMAT_TOTAL_TIME_RUNNING;
+			auto const fd = static_cast<int>(
+			   syscall(SYS_perf_event_open, &attr, 0, -1, i == 0 ? -1 : fds_[0], 0UL));
+			if (fd < 0) {
+				close_all();
+				return;
+			}
+			fds_[i] = fd;
+		}
+#endif
+	}
+
+	perf_counters(perf_counters const&) = delete;
+	auto operator=(perf_counters const&) -> perf_counters& = delete;
+
+	~perf_counters() {
+		close_all();
+	}
+
+	[[nodiscard]] auto available() const noexcept -> bool {
+		return fds_[0] >= 0;
+	}
+
+	auto start() noexcept -> void {
+#ifdef __linux__
+		if (available()) {
+			ioctl(fds_[0], PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+			ioctl(fds_[0], PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+		}
+#endif
+	}
+
+	// counts since start(), added to the previous ones
+	auto stop() noexcept -> void {
+#ifdef __linux__
+		if (not available()) {
+			return;
+		}
+		ioctl(fds_[0], PERF_EVENT_IOC_DISABLE, PERF_IOC_FLAG_GROUP);
+		// {number of events, time enabled, time running, value...}
+		auto buffer = std::array<std::uint64_t, 3 + names.size()>{};
+		if (read(fds_[0], buffer.data(), sizeof(buffer)) != static_cast<ssize_t>(sizeof(buffer))) {
+			return;
+		}
+		auto const enabled = static_cast<double>(buffer[1]);
+		auto const running = static_cast<double>(buffer[2]);
+		auto const scale = running > 0 ? enabled / running : 0.0;
+		for (auto i = std::size_t{0}; i < names.size(); ++i) {
+			totals_[i] += static_cast<double>(buffer[3 + i]) * scale;
+		}
+#endif
+	}
+
+	auto report(benchmark::State& state) const -> void {
+		if (not available()) {
+			state.SetLabel("no perf counters");
+			return;
+		}
+		for (auto i = std::size_t{0}; i < names.size(); ++i) {
+			state.counters[std::string(names[i])] =
+			   benchmark::Counter(totals_[i], benchmark::Counter::kAvgIterations);
+		}
+	}
+
+private:
+	auto close_all() noexcept -> void {
+#ifdef __linux__
+		for (auto& fd : fds_) {
+			if (fd >= 0) {
+				close(fd);
+				fd = -1;
+			}
+		}
+#endif
+	}
+
+	std::array<int, 4> fds_ = {-1, -1, -1, -1};
+	std::array<double, 4> totals_ = {};
+};
+
+#endif // GDWG_BENCHMARK_PERF_COUNTERS_HPP
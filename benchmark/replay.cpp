@@ -0,0 +1,284 @@
+// Replays a mix of graph operations on one shared gdwg::graph<int, int> from several threads, at a
+// target rate, and reports the throughput and the latency percentiles of every kind of operation.
+//
+// The operations come from the trace file named by GDWG_REPLAY_TRACE, one per line:
+//     insert_edge src dst weight
+//     erase_edge src dst weight
+//     is_connected src dst
+//     weights src dst
+//     connections src
+//     merge_replace_node old new
+// Without a trace, a synthetic mix is generated over an R-MAT graph, so that the operations hit the
+// same skewed set of hot nodes as a real workload. Every node named by the trace is inserted before
+// the replay, and merge_replace_node re-inserts old: the set of nodes never changes.
+//
+// The graph is shared behind a std::shared_mutex: the queries take it shared, the modifiers
+// exclusive. Thread t replays operations t, t + threads, t + 2 * threads, ... of the trace,
+// modulo its length.
+// The argument is the total target rate in operations per second (0 = as fast as possible).
+// Latencies are measured from the time an operation was scheduled, not from the time it started,
+// so that a stall delays (and is charged to) every operation queued behind it.
+// The hardware counters of every thread are added up and reported per operation.
+#include "perf_counters.hpp"
+
+#include <algorithm>
+#include <array>
+#include <benchmark/benchmark.h>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <exception>
+#include <fstream>
+#include <gdwg/generate.hpp>
+#include <gdwg/graph.hpp>
+#include <mutex>
+#include <random>
+#include <shared_mutex>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+	enum class op_kind {
+		insert_edge,
+		erase_edge,
+		is_connected,
+		weights,
+		connections,
+		merge_replace_node,
+	};
+
+	constexpr auto op_names = std::array{
+	   "insert_edge", "erase_edge", "is_connected", "weights", "connections", "merge_replace_node"};
+	constexpr auto num_op_kinds = op_names.size();
+
+	struct operation {
+		op_kind kind;
+		int a;
+		int b;
+		int weight;
+	};
+
+	auto parse_trace(std::istream& in) -> std::vector<operation> {
+		auto trace = std::vector<operation>{};
+		auto line = std::string{};
+		while (std::getline(in, line)) {
+			auto fields = std::istringstream(line);
+			auto name = std::string{};
+			if (not(fields >> name) or name.starts_with('#')) {
+				continue;
+			}
+			auto const it = std::find(op_names.begin(), op_names.end(), name);
+			if (it == op_names.end()) {
+				throw std::runtime_error("replay: unknown operation in trace: " + name);
+			}
+			auto op = operation{static_cast<op_kind>(it - op_names.begin()), 0, 0, 0};
+			fields >> op.a;
+			if (op.kind != op_kind::connections) {
+				fields >> op.b;
+			}
+			if (op.kind == op_kind::insert_edge or op.kind == op_kind::erase_edge) {
+				fields >> op.weight;
+			}
+			if (fields.fail()) {
+				throw std::runtime_error("replay: malformed trace line: " + line);
+			}
+			trace.push_back(op);
+		}
+		return trace;
+	}
+
+	// read heavy mix: 30% insert_edge, 10% erase_edge, 25% is_connected, 15% weights,
+	// 19% connections, 1% merge_replace_node. Endpoints are R-MAT edges ==> skewed
+	auto synthetic_trace() -> std::vector<operation> {
+		auto const edges = gdwg::generate::rmat<int, int>({.scale = 12, .edge_factor = 16}, 100);
+		auto engine = std::mt19937(6771);
+		auto percent = std::uniform_int_distribution<int>(0, 99);
+		auto trace = std::vector<operation>{};
+		trace.reserve(edges.size());
+		for (auto const& e : edges) {
+			auto const p = percent(engine);
+			auto const kind = p < 30   ? op_kind::insert_edge
+			                  : p < 40 ? op_kind::erase_edge
+			                  : p < 65 ? op_kind::is_connected
+			                  : p < 80 ? op_kind::weights
+			                  : p < 99 ? op_kind::connections
+			                           : op_kind::merge_replace_node;
+			trace.push_back({kind, e.from, e.to, e.weight});
+		}
+		return trace;
+	}
+
+	auto load_trace() -> std::vector<operation> {
+		auto const* path = std::getenv("GDWG_REPLAY_TRACE");
+		if (path == nullptr) {
+			return synthetic_trace();
+		}
+		auto in = std::ifstream(path);
+		if (not in) {
+			throw std::runtime_error(std::string("replay: cannot open ") + path);
+		}
+		return parse_trace(in);
+	}
+
+	auto initial_graph(std::vector<operation> const& trace) -> gdwg::graph<int, int> {
+		auto g = gdwg::graph<int, int>{};
+		for (auto const& op : trace) {
+			g.insert_node(op.a);
+			if (op.kind != op_kind::connections) {
+				g.insert_node(op.b);
+			}
+		}
+		return g;
+	}
+
+	// state shared by the threads of one run, set up by thread 0 before the timed loop
+	struct shared_state {
+		// loaded by thread 0 of the first run. A trace that can't be loaded leaves error set, and
+		// every run is skipped with it
+		bool loaded = false;
+		std::string error;
+		std::vector<operation> trace;
+		gdwg::graph<int, int> graph;
+		std::shared_mutex mutex;
+		// [thread][kind] ==> latencies in ns
+		std::vector<std::array<std::vector<std::int64_t>, num_op_kinds>> latencies;
+	};
+
+	auto shared() -> shared_state& {
+		static auto state = shared_state{};
+		return state;
+	}
+
+	auto run(shared_state& s, operation const& op) -> void {
+		switch (op.kind) {
+		case op_kind::insert_edge: {
+			auto const lock = std::unique_lock(s.mutex);
+			s.graph.insert_edge(op.a, op.b, op.weight);
+			break;
+		}
+		case op_kind::erase_edge: {
+			auto const lock = std::unique_lock(s.mutex);
+			s.graph.erase_edge(op.a, op.b, op.weight);
+			break;
+		}
+		case op_kind::is_connected: {
+			auto const lock = std::shared_lock(s.mutex);
+			benchmark::DoNotOptimize(s.graph.is_connected(op.a, op.b));
+			break;
+		}
+		case op_kind::weights: {
+			auto const lock = std::shared_lock(s.mutex);
+			benchmark::DoNotOptimize(s.graph.weights(op.a, op.b));
+			break;
+		}
+		case op_kind::connections: {
+			auto const lock = std::shared_lock(s.mutex);
+			benchmark::DoNotOptimize(s.graph.connections(op.a));
+			break;
+		}
+		case op_kind::merge_replace_node: {
+			auto const lock = std::unique_lock(s.mutex);
+			if (op.a != op.b) {
+				s.graph.merge_replace_node(op.a, op.b);
+				s.graph.insert_node(op.a);
+			}
+			break;
+		}
+		}
+	}
+
+	auto percentile(std::vector<std::int64_t> const& sorted_samples, double p) -> double {
+		auto const last = static_cast<double>(sorted_samples.size() - 1);
+		auto const rank = static_cast<std::size_t>(p * last);
+		return static_cast<double>(sorted_samples[rank]);
+	}
+
+	auto report(benchmark::State& state, shared_state& s) -> void {
+		for (auto kind = std::size_t{0}; kind < num_op_kinds; ++kind) {
+			auto samples = std::vector<std::int64_t>{};
+			for (auto& per_thread : s.latencies) {
+				samples.insert(samples.end(), per_thread[kind].begin(), per_thread[kind].end());
+			}
+			if (samples.empty()) {
+				continue;
+			}
+			std::sort(samples.begin(), samples.end());
+			auto const name = std::string(op_names[kind]);
+			state.counters[name + ".p50_ns"] = percentile(samples, 0.50);
+			state.counters[name + ".p99_ns"] = percentile(samples, 0.99);
+			state.counters[name + ".p999_ns"] = percentile(samples, 0.999);
+			state.counters[name + ".ops"] =
+			   benchmark::Counter(static_cast<double>(samples.size()), benchmark::Counter::kIsRate);
+		}
+	}
+
+	auto replay(benchmark::State& state) -> void {
+		auto& s = shared();
+		auto const thread = static_cast<std::size_t>(state.thread_index());
+		auto const threads = static_cast<std::size_t>(state.threads());
+		if (thread == 0) {
+			if (not s.loaded) {
+				try {
+					s.trace = load_trace();
+				} catch (std::exception const& e) {
+					s.error = e.what();
+				}
+				if (s.error.empty() and s.trace.empty()) {
+					s.error = "replay: empty trace";
+				}
+				s.loaded = true;
+			}
+			if (s.error.empty()) {
+				s.graph = initial_graph(s.trace);
+				s.latencies.assign(threads, {});
+			}
+		}
+		// the start of the timed loop waits for every thread ==> the setup above is complete, and
+		// the trace may only be looked at inside the loop. Every thread has to enter the loop,
+		// even to skip the run: the other threads wait for it there
+		auto const rate = static_cast<double>(state.range(0));
+		auto const interval = std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+		   std::chrono::duration<double>(rate == 0 ? 0.0 : static_cast<double>(threads) / rate));
+		auto next = std::size_t{0};
+		auto scheduled = std::chrono::steady_clock::time_point{};
+		auto counters = perf_counters{};
+		counters.start();
+		for (auto _ : state) {
+			if (scheduled == std::chrono::steady_clock::time_point{}) {
+				if (not s.error.empty()) {
+					state.SkipWithError(s.error.c_str());
+					break;
+				}
+				// more threads than operations ==> some threads start on the same one
+				next = thread % s.trace.size();
+				scheduled = std::chrono::steady_clock::now();
+			}
+			if (interval.count() > 0) {
+				std::this_thread::sleep_until(scheduled);
+			}
+			else {
+				scheduled = std::chrono::steady_clock::now();
+			}
+			auto const& op = s.trace[next];
+			run(s, op);
+			auto const latency = std::chrono::steady_clock::now() - scheduled;
+			s.latencies[thread][static_cast<std::size_t>(op.kind)].push_back(
+			   std::chrono::duration_cast<std::chrono::nanoseconds>(latency).count());
+			scheduled += interval;
+			next = (next + threads) % s.trace.size();
+		}
+		counters.stop();
+		counters.report(state);
+		state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations()));
+		// the end of the timed loop waits for every thread ==> every latency is recorded
+		if (thread == 0 and s.error.empty()) {
+			report(state, s);
+		}
+	}
+} // namespace
+
+BENCHMARK(replay)->Arg(0)->Arg(100'000)->ThreadRange(1, 8)->UseRealTime();
@@ -0,0 +1,335 @@
+#ifndef GDWG_CRITICAL_PATH_HPP
+#define GDWG_CRITICAL_PATH_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <gdwg/detail/csr.hpp>
+#include <gdwg/detail/parallel.hpp>
+#include <gdwg/graph.hpp>
+#include <limits>
+#include <map>
+#include <queue>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace gdwg {
+	namespace detail {
+		// longest path lengths of a DAG whose edge weights are durations, for every node:
+		//   head[v] = longest path from a source to v (0 at the sources)
+		//   tail[v] = longest path from v to a sink (0 at the sinks)
+		// Both are computed as wavefronts, one level of the DAG after the other, every node of a
+		// level pulling from the level before it, in parallel. A weight change then only
+		// revisits the nodes whose head or tail actually changes
+		template<typename N, typename E>
+		class dag_lengths {
+		public:
+			// order must be a topological order of c
+			dag_lengths(csr<N, E> c, std::vector<std::size_t> const& order, std::size_t threads)
+			: csr_{std::move(c)}
+			, position_(csr_.size())
+			, in_offsets_(csr_.size() + 1, 0)
+			, in_edges_(csr_.targets.size()) {
+				auto const n = csr_.size();
+				for (auto i = std::size_t{0}; i < n; ++i) {
+					position_[order[i]] = i;
+				}
+				for (auto const v : csr_.targets) {
+					++in_offsets_[v + 1];
+				}
+				for (auto v = std::size_t{0}; v < n; ++v) {
+					in_offsets_[v + 1] += in_offsets_[v];
+				}
+				auto next = std::vector<std::size_t>(in_offsets_.begin(), in_offsets_.end() - 1);
+				for (auto u = std::size_t{0}; u < n; ++u) {
+					for (auto e = csr_.offsets[u]; e < csr_.offsets[u + 1]; ++e) {
+						in_edges_[next[csr_.targets[e]]++] = e;
+						source_of_.push_back(u);
+					}
+				}
+
+				head_.assign(n, E{});
+				tail_.assign(n, E{});
+				// below a few thousand nodes, starting threads costs more than it saves
+				auto const workers = n < 4096 ? std::size_t{1} : thread_count(threads, n / 64);
+				for_each_level(depth_levels(csr_, order), workers, [this](std::size_t v) {
+					head_[v] = pull_head(v);
+				});
+				for_each_level(height_levels(csr_, order), workers, [this](std::size_t u) {
+					tail_[u] = pull_tail(u);
+				});
+				for (auto v = std::size_t{0}; v < n; ++v) {
+					if (is_source(v)) {
+						++source_tails_[tail_[v]];
+					}
+				}
+			}
+
+			[[nodiscard]] auto snapshot() const noexcept -> csr<N, E> const& {
+				return csr_;
+			}
+			[[nodiscard]] auto head(std::size_t v) const noexcept -> E {
+				return head_[v];
+			}
+			[[nodiscard]] auto tail(std::size_t v) const noexcept -> E {
+				return tail_[v];
+			}
+
+			// of the longest path from a source to a sink, the largest tail of a source. Taken from
+			// the tails only, like path() and latest starts: with floating-point weights, the heads
+			// are summed in the other direction and round differently. O(1)
+			[[nodiscard]] auto length() const -> E {
+				return source_tails_.empty() ? E{} : source_tails_.rbegin()->first;
+			}
+
+			// the id of the edge from u to v of this weight, csr_.targets.size() if there is none
+			[[nodiscard]] auto edge_of(std::size_t u, std::size_t v, E const& weight) const
+			   -> std::size_t {
+				for (auto e = csr_.offsets[u]; e < csr_.offsets[u + 1]; ++e) {
+					if (csr_.targets[e] == v and csr_.weights[e] == weight) {
+						return e;
+					}
+				}
+				return csr_.targets.size();
+			}
+
+			// the source of largest tail, then always the out-edge of largest weight + tail of its
+			// target. Largest, not equal to the tail: floating-point sums needn't match exactly
+			[[nodiscard]] auto path() const -> std::vector<N> {
+				auto const n = csr_.size();
+				auto result = std::vector<N>{};
+				auto u = n;
+				for (auto v = std::size_t{0}; v < n; ++v) {
+					if (is_source(v) and (u == n or tail_[u] < tail_[v])) {
+						u = v;
+					}
+				}
+				while (u != n) {
+					result.push_back(csr_.nodes[u]);
+					auto next = n;
+					auto best = E{};
+					for (auto e = csr_.offsets[u]; e < csr_.offsets[u + 1]; ++e) {
+						auto const candidate = csr_.weights[e] + tail_[csr_.targets[e]];
+						if (next == n or best < candidate) {
+							next = csr_.targets[e];
+							best = candidate;
+						}
+					}
+					u = next;
+				}
+				return result;
+			}
+
+			// heads are repaired forward from the target of the edge in topological order, tails
+			// backward from its source, each stopping where the value doesn't change
+			auto update_weight(std::size_t edge, E const& weight) -> void {
+				csr_.weights[edge] = weight;
+				auto const u = source_of_[edge];
+				auto const v = csr_.targets[edge];
+
+				auto forward = std::priority_queue<std::pair<std::size_t, std::size_t>,
+				                                   std::vector<std::pair<std::size_t, std::size_t>>,
+				                                   std::greater<>>{};
+				forward.emplace(position_[v], v);
+				while (not forward.empty()) {
+					auto const x = forward.top().second;
+					forward.pop();
+					auto const updated = pull_head(x);
+					if (updated == head_[x]) {
+						continue;
+					}
+					head_[x] = updated;
+					for (auto e = csr_.offsets[x]; e < csr_.offsets[x + 1]; ++e) {
+						forward.emplace(position_[csr_.targets[e]], csr_.targets[e]);
+					}
+				}
+
+				auto backward = std::priority_queue<std::pair<std::size_t, std::size_t>>{};
+				backward.emplace(position_[u], u);
+				while (not backward.empty()) {
+					auto const x = backward.top().second;
+					backward.pop();
+					auto const updated = pull_tail(x);
+					if (updated == tail_[x]) {
+						continue;
+					}
+					if (is_source(x)) {
+						if (--source_tails_[tail_[x]] == 0) {
+							source_tails_.erase(tail_[x]);
+						}
+						++source_tails_[updated];
+					}
+					tail_[x] = updated;
+					for (auto i = in_offsets_[x]; i < in_offsets_[x + 1]; ++i) {
+						auto const w = source_of_[in_edges_[i]];
+						backward.emplace(position_[w], w);
+					}
+				}
+			}
+
+		private:
+			auto is_source(std::size_t v) const noexcept -> bool {
+				return in_offsets_[v] == in_offsets_[v + 1];
+			}
+
+			auto pull_head(std::size_t v) const -> E {
+				auto result = E{};
+				for (auto i = in_offsets_[v]; i < in_offsets_[v + 1]; ++i) {
+					auto const e = in_edges_[i];
+					auto const candidate = head_[source_of_[e]] + csr_.weights[e];
+					result = i == in_offsets_[v] ? candidate : std::max(result, candidate);
+				}
+				return result;
+			}
+
+			auto pull_tail(std::size_t u) const -> E {
+				auto result = E{};
+				for (auto e = csr_.offsets[u]; e < csr_.offsets[u + 1]; ++e) {
+					auto const candidate = csr_.weights[e] + tail_[csr_.targets[e]];
+					result = e == csr_.offsets[u] ? candidate : std::max(result, candidate);
+				}
+				return result;
+			}
+
+			csr<N, E> csr_;
+			std::vector<std::size_t> position_;
+			// the ids of the in-edges of v are in_edges_[in_offsets_[v] .. in_offsets_[v + 1])
+			std::vector<std::size_t> in_offsets_;
+			std::vector<std::size_t> in_edges_;
+			std::vector<std::size_t> source_of_;
+			std::vector<E> head_;
+			std::vector<E> tail_;
+			// tail of every source ==> the length is the largest key
+			std::map<E, std::size_t> source_tails_;
+		};
+	} // namespace detail
+
+	// critical path analysis of a DAG whose edge weights are durations: src -> dst of weight w
+	// means dst can start w after src started. For every node:
+	//   earliest_start = longest path from a source to it
+	//   latest_start   = length() - longest path from it to a sink
+	//   slack          = latest_start - earliest_start, 0 on a critical path
+	//
+	// Like dynamic_sssp, the analysis is attached to the graph: weight changes must go through
+	// update_weight() below, which forwards to the graph and repairs only the nodes whose times
+	// change. After any other change of the graph, call recompute()
+	template<typename N, typename E>
+	requires std::is_arithmetic_v<E> class critical_path {
+	public:
+		// threads = 0 ==> one per core
+		explicit critical_path(graph<N, E>& g, std::size_t threads = 0)
+		: graph_{&g}
+		, threads_{threads}
+		, lengths_{make_lengths(g, threads)} {}
+
+		// false if there is no edge {src, dst, old_weight}. If {src, dst, new_weight} already
+		// exists the two edges merge in the graph and everything is recomputed
+		auto update_weight(N const& src, N const& dst, E const& old_weight, E const& new_weight)
+		   -> bool {
+			auto const& c = lengths_.snapshot();
+			auto const u = c.id_of(src);
+			auto const v = c.id_of(dst);
+			if (not u or not v) {
+				throw std::runtime_error("Cannot call gdwg::critical_path<N, E>::update_weight on src "
+				                         "or dst if they don't exist in the graph");
+			}
+			auto const merges = not(old_weight == new_weight)
+			                    and lengths_.edge_of(*u, *v, new_weight) != c.targets.size();
+			if (not graph_->update_weight(src, dst, old_weight, new_weight)) {
+				return false;
+			}
+			if (merges) {
+				recompute();
+			}
+			else {
+				lengths_.update_weight(lengths_.edge_of(*u, *v, old_weight), new_weight);
+			}
+			return true;
+		}
+
+		// O(n + e log e) on threads threads
+		auto recompute() -> void {
+			lengths_ = make_lengths(*graph_, threads_);
+		}
+
+		// of the longest path from a source to a sink
+		[[nodiscard]] auto length() const -> E {
+			return lengths_.length();
+		}
+
+		[[nodiscard]] auto earliest_start(N const& node) const -> E {
+			return lengths_.head(id_of(node, "earliest_start"));
+		}
+
+		[[nodiscard]] auto latest_start(N const& node) const -> E {
+			return length() - lengths_.tail(id_of(node, "latest_start"));
+		}
+
+		// 0 on a critical path. With floating-point weights, the head and tail of a critical node
+		// are summed in opposite directions: the difference within their rounding error is 0
+		[[nodiscard]] auto slack(N const& node) const -> E {
+			auto const v = id_of(node, "slack");
+			auto const result = length() - lengths_.tail(v) - lengths_.head(v);
+			if constexpr (std::is_floating_point_v<E>) {
+				auto const nodes = static_cast<E>(lengths_.snapshot().size());
+				auto const rounding = std::numeric_limits<E>::epsilon() * nodes * length();
+				return result <= rounding ? E{} : result;
+			}
+			else {
+				return result;
+			}
+		}
+
+		// the nodes of one longest path from a source to a sink, empty for an empty graph
+		[[nodiscard]] auto nodes() const -> std::vector<N> {
+			return lengths_.path();
+		}
+
+		[[nodiscard]] auto get_graph() const noexcept -> graph<N, E> const& {
+			return *graph_;
+		}
+
+	private:
+		static auto make_lengths(graph<N, E> const& g, std::size_t threads)
+		   -> detail::dag_lengths<N, E> {
+			auto c = detail::to_csr(g);
+			auto const order = detail::topological_order(c);
+			if (not order) {
+				throw std::runtime_error("Cannot use gdwg::critical_path<N, E> on a graph with a "
+				                         "cycle");
+			}
+			return detail::dag_lengths<N, E>(std::move(c), *order, threads);
+		}
+
+		auto id_of(N const& node, char const* caller) const -> std::size_t {
+			auto const id = lengths_.snapshot().id_of(node);
+			if (not id) {
+				throw std::runtime_error(std::string("Cannot call gdwg::critical_path<N, E>::") + caller
+				                         + " on a node that doesn't exist in the graph");
+			}
+			return *id;
+		}
+
+		graph<N, E>* graph_;
+		std::size_t threads_;
+		detail::dag_lengths<N, E> lengths_;
+	};
+
+	// the nodes of one longest path of a DAG from a source to a sink, edge weights as lengths.
+	// O(n + e log e), each level of the DAG in parallel on threads threads (0 ==> one per core)
+	template<typename N, typename E>
+	requires std::is_arithmetic_v<E> auto longest_path(graph<N, E> const& g, std::size_t threads = 0)
+	   -> std::vector<N> {
+		auto c = detail::to_csr(g);
+		auto const order = detail::topological_order(c);
+		if (not order) {
+			throw std::runtime_error("Cannot compute gdwg::longest_path of a graph with a cycle");
+		}
+		return detail::dag_lengths<N, E>(std::move(c), *order, threads).path();
+	}
+} // namespace gdwg
+
+#endif // GDWG_CRITICAL_PATH_HPP
@@ -0,0 +1,355 @@
+#ifndef GDWG_DAG_HPP
+#define GDWG_DAG_HPP
+
+#include <algorithm>
+#include <concepts/concepts.hpp>
+#include <cstddef>
+#include <gdwg/detail/csr.hpp>
+#include <gdwg/graph.hpp>
+#include <initializer_list>
+#include <map>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace gdwg {
+	// a graph<N, E> that stays acyclic: insert_edge throws instead of closing a cycle.
+	//
+	// A topological order of the nodes is maintained incrementally (Pearce-Kelly). An edge
+	// src -> dst that already goes forward in the order is accepted in O(log n). Otherwise only
+	// the nodes ordered between dst and src are searched: forward from dst and backward from src.
+	// Reaching src from dst means a cycle; if not, the two visited sets swap their positions in
+	// the order, everything outside [dst, src] is untouched. topological_order() is then a copy
+	// of the order, O(n).
+	template<concepts::regular N, concepts::regular E>
+	requires concepts::totally_ordered<N> and concepts::totally_ordered<E> class dag {
+	public:
+		using value_type = typename graph<N, E>::value_type;
+		using iterator = typename graph<N, E>::iterator;
+
+		dag() = default;
+
+		dag(std::initializer_list<N> il) {
+			for (auto const& value : il) {
+				insert_node(value);
+			}
+		}
+
+		// O(n log n + e log e)
+		explicit dag(graph<N, E> const& g) {
+			auto const c = detail::to_csr(g);
+			auto const order = detail::topological_order(c);
+			if (not order) {
+				throw std::runtime_error("Cannot create gdwg::dag<N, E> from a graph with a cycle");
+			}
+			graph_ = g;
+			auto const n = c.size();
+			values_ = c.nodes;
+			ord_.resize(n);
+			order_ = *order;
+			for (auto i = std::size_t{0}; i < n; ++i) {
+				ids_.emplace_hint(ids_.end(), values_[i], i);
+				ord_[order_[i]] = i;
+			}
+			out_.resize(n);
+			in_.resize(n);
+			for (auto u = std::size_t{0}; u < n; ++u) {
+				for (auto e = c.offsets[u]; e < c.offsets[u + 1]; ++e) {
+					out_[u].push_back(c.targets[e]);
+					in_[c.targets[e]].push_back(u);
+				}
+			}
+			mark_.assign(n, false);
+		}
+
+		//---------------------------- modifiers -----------------------------------------
+		// a new node goes last in the order
+		auto insert_node(N const& value) -> bool {
+			if (not graph_.insert_node(value)) {
+				return false;
+			}
+			auto id = values_.size();
+			if (free_.empty()) {
+				values_.push_back(value);
+				ord_.push_back(0);
+				out_.emplace_back();
+				in_.emplace_back();
+				mark_.push_back(false);
+			}
+			else {
+				id = free_.back();
+				free_.pop_back();
+				values_[id] = value;
+			}
+			ids_.emplace(value, id);
+			ord_[id] = order_.size();
+			order_.push_back(id);
+			return true;
+		}
+
+		// O(log n) when src is already ordered before dst. Otherwise O(k log k) plus the edges
+		// of the k nodes visited between dst and src
+		auto insert_edge(N const& src, N const& dst, E const& weight) -> bool {
+			auto const x = find_id(src);
+			auto const y = find_id(dst);
+			if (x == npos or y == npos) {
+				throw std::runtime_error("Cannot call gdwg::dag<N, E>::insert_edge when either src or "
+				                         "dst node does not exist");
+			}
+			if (x == y or (ord_[y] < ord_[x] and not reorder(x, y))) {
+				throw std::runtime_error("Cannot call gdwg::dag<N, E>::insert_edge with an edge that "
+				                         "would create a cycle");
+			}
+			if (not graph_.insert_edge(src, dst, weight)) {
+				return false;
+			}
+			out_[x].push_back(y);
+			in_[y].push_back(x);
+			return true;
+		}
+
+		// a renamed node keeps its edges and its place in the order
+		auto replace_node(N const& old_data, N const& new_data) -> bool {
+			auto node = ids_.extract(old_data);
+			if (node.empty()) {
+				throw std::runtime_error("Cannot call gdwg::dag<N, E>::replace_node on a node that "
+				                         "doesn't exist");
+			}
+			if (not graph_.replace_node(old_data, new_data)) {
+				ids_.insert(std::move(node));
+				return false;
+			}
+			node.key() = new_data;
+			values_[node.mapped()] = new_data;
+			ids_.insert(std::move(node));
+			return true;
+		}
+
+		// O(n + degree): the nodes ordered after value move up one position
+		auto erase_node(N const& value) -> bool {
+			auto const x = find_id(value);
+			if (x == npos) {
+				return false;
+			}
+			graph_.erase_node(value);
+			for (auto const v : out_[x]) {
+				remove_one(in_[v], x);
+			}
+			for (auto const u : in_[x]) {
+				remove_one(out_[u], x);
+			}
+			out_[x].clear();
+			in_[x].clear();
+			order_.erase(order_.begin() + static_cast<std::ptrdiff_t>(ord_[x]));
+			for (auto i = ord_[x]; i < order_.size(); ++i) {
+				ord_[order_[i]] = i;
+			}
+			ids_.erase(value);
+			free_.push_back(x);
+			return true;
+		}
+
+		auto erase_edge(N const& src, N const& dst, E const& weight) -> bool {
+			auto const x = find_id(src);
+			auto const y = find_id(dst);
+			if (x == npos or y == npos) {
+				throw std::runtime_error("Cannot call gdwg::dag<N, E>::erase_edge on src or dst if "
+				                         "they don't exist in the graph");
+			}
+			if (not graph_.erase_edge(src, dst, weight)) {
+				return false;
+			}
+			remove_one(out_[x], y);
+			remove_one(in_[y], x);
+			return true;
+		}
+
+		// the weight has no effect on the order
+		auto update_weight(N const& src, N const& dst, E const& old_weight, E const& new_weight)
+		   -> bool {
+			return graph_.update_weight(src, dst, old_weight, new_weight);
+		}
+
+		auto clear() noexcept -> void {
+			graph_.clear();
+			ids_.clear();
+			values_.clear();
+			ord_.clear();
+			order_.clear();
+			out_.clear();
+			in_.clear();
+			mark_.clear();
+			free_.clear();
+		}
+
+		//-------------------------------- Accessors --------------------------------------------
+		[[nodiscard]] auto is_node(N const& value) const -> bool {
+			return graph_.is_node(value);
+		}
+
+		[[nodiscard]] auto empty() const -> bool {
+			return graph_.empty();
+		}
+
+		[[nodiscard]] auto is_connected(N const& src, N const& dst) const -> bool {
+			return graph_.is_connected(src, dst);
+		}
+
+		[[nodiscard]] auto nodes() const -> std::vector<N> {
+			return graph_.nodes();
+		}
+
+		[[nodiscard]] auto weights(N const& src, N const& dst) const -> std::vector<E> {
+			return graph_.weights(src, dst);
+		}
+
+		[[nodiscard]] auto find(N const& src, N const& dst, E const& weight) const -> iterator {
+			return graph_.find(src, dst, weight);
+		}
+
+		[[nodiscard]] auto connections(N const& src) const -> std::vector<N> {
+			return graph_.connections(src);
+		}
+
+		// every edge goes from a node to a node later in the result. O(n)
+		[[nodiscard]] auto topological_order() const -> std::vector<N> {
+			auto result = std::vector<N>{};
+			result.reserve(order_.size());
+			for (auto const id : order_) {
+				result.push_back(values_[id]);
+			}
+			return result;
+		}
+
+		// whether a is before b in topological_order(). O(log n)
+		[[nodiscard]] auto precedes(N const& a, N const& b) const -> bool {
+			auto const x = find_id(a);
+			auto const y = find_id(b);
+			if (x == npos or y == npos) {
+				throw std::runtime_error("Cannot call gdwg::dag<N, E>::precedes on nodes that don't "
+				                         "exist in the graph");
+			}
+			return ord_[x] < ord_[y];
+		}
+
+		// read only: changes must go through the dag to keep it acyclic
+		[[nodiscard]] auto as_graph() const noexcept -> graph<N, E> const& {
+			return graph_;
+		}
+
+		[[nodiscard]] auto begin() const -> iterator {
+			return graph_.begin();
+		}
+
+		[[nodiscard]] auto end() const -> iterator {
+			return graph_.end();
+		}
+
+		[[nodiscard]] auto operator==(dag const& other) const -> bool {
+			return graph_ == other.graph_;
+		}
+
+	private:
+		static constexpr auto npos = static_cast<std::size_t>(-1);
+
+		auto find_id(N const& value) const -> std::size_t {
+			auto const it = ids_.find(value);
+			return it == ids_.end() ? npos : it->second;
+		}
+
+		static auto remove_one(std::vector<std::size_t>& ids, std::size_t id) -> void {
+			auto const it = std::find(ids.begin(), ids.end(), id);
+			*it = ids.back();
+			ids.pop_back();
+		}
+
+		// makes room for x -> y when y is ordered before x. false if y reaches x
+		auto reorder(std::size_t x, std::size_t y) -> bool {
+			auto const lower = ord_[y];
+			auto const upper = ord_[x];
+			auto forward = std::vector<std::size_t>{};
+			auto const acyclic =
+			   search(y, x, out_, forward, [&](std::size_t v) { return ord_[v] < upper; });
+			if (not acyclic) {
+				unmark(forward);
+				return false;
+			}
+			auto backward = std::vector<std::size_t>{};
+			search(x, npos, in_, backward, [&](std::size_t v) { return lower < ord_[v]; });
+			unmark(forward);
+			unmark(backward);
+
+			// the nodes reaching x, then the nodes reachable from y, in the positions they held
+			auto const by_ord = [this](std::size_t a, std::size_t b) { return ord_[a] < ord_[b]; };
+			std::sort(forward.begin(), forward.end(), by_ord);
+			std::sort(backward.begin(), backward.end(), by_ord);
+			auto positions = std::vector<std::size_t>{};
+			positions.reserve(forward.size() + backward.size());
+			for (auto const v : backward) {
+				positions.push_back(ord_[v]);
+			}
+			for (auto const v : forward) {
+				positions.push_back(ord_[v]);
+			}
+			std::sort(positions.begin(), positions.end());
+			auto next = positions.begin();
+			for (auto const* part : {&backward, &forward}) {
+				for (auto const v : *part) {
+					ord_[v] = *next++;
+					order_[ord_[v]] = v;
+				}
+			}
+			return true;
+		}
+
+		// depth first from start through the nodes accepted by within, marking them and appending
+		// them to visited. false as soon as target is reached
+		template<typename Within>
+		auto search(std::size_t start,
+		            std::size_t target,
+		            std::vector<std::vector<std::size_t>> const& adjacency,
+		            std::vector<std::size_t>& visited,
+		            Within const& within) -> bool {
+			mark_[start] = true;
+			visited.push_back(start);
+			auto stack = std::vector<std::size_t>{start};
+			while (not stack.empty()) {
+				auto const u = stack.back();
+				stack.pop_back();
+				for (auto const v : adjacency[u]) {
+					if (v == target) {
+						return false;
+					}
+					if (mark_[v] or not within(v)) {
+						continue;
+					}
+					mark_[v] = true;
+					visited.push_back(v);
+					stack.push_back(v);
+				}
+			}
+			return true;
+		}
+
+		auto unmark(std::vector<std::size_t> const& visited) -> void {
+			for (auto const v : visited) {
+				mark_[v] = false;
+			}
+		}
+
+		graph<N, E> graph_;
+		std::map<N, std::size_t> ids_;
+		// by id
+		std::vector<N> values_;
+		std::vector<std::size_t> ord_;
+		std::vector<std::vector<std::size_t>> out_;
+		std::vector<std::vector<std::size_t>> in_;
+		std::vector<bool> mark_;
+		// by position in the order
+		std::vector<std::size_t> order_;
+		// ids of erased nodes, reused by insert_node
+		std::vector<std::size_t> free_;
+	};
+} // namespace gdwg
+
+#endif // GDWG_DAG_HPP
@@ -0,0 +1,198 @@
+#ifndef GDWG_DAG_EXECUTOR_HPP
+#define GDWG_DAG_EXECUTOR_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <exception>
+#include <gdwg/critical_path.hpp>
+#include <gdwg/detail/csr.hpp>
+#include <gdwg/detail/parallel.hpp>
+#include <gdwg/graph.hpp>
+#include <mutex>
+#include <optional>
+#include <stdexcept>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace gdwg {
+	// runs one task per node of a DAG, each as soon as the tasks of all its predecessors returned.
+	//
+	// An edge src -> dst means dst depends on src, and its weight is the duration of src on that
+	// path. Every worker thread owns a heap of ready tasks ordered by priority, the longest duration
+	// from the node to the end of the DAG, so the critical path is never left waiting behind
+	// shorter chains. A worker pushes the tasks it made ready onto its own heap and, when that is
+	// empty, steals the most urgent task of another worker.
+	//
+	// The graph is copied at construction: later changes of it are not reflected
+	template<typename N, typename E>
+	requires std::is_arithmetic_v<E> class dag_executor {
+	public:
+		// threads = 0 ==> one per core
+		explicit dag_executor(graph<N, E> const& g, std::size_t threads = 0)
+		: lengths_{make_lengths(g, threads)}
+		, threads_{detail::thread_count(threads, lengths_.snapshot().size())} {
+			auto const& c = lengths_.snapshot();
+			in_degree_.assign(c.size(), 0);
+			for (auto const v : c.targets) {
+				++in_degree_[v];
+			}
+		}
+
+		// calls task(node) once for every node and returns when all the calls returned. If a task
+		// throws, the tasks that haven't started are skipped and the first exception is rethrown
+		template<typename F>
+		auto run(F&& task) -> void {
+			auto state = run_state(*this);
+			auto const work = [&](std::size_t me) { state.work(me, task); };
+			auto workers = std::vector<std::jthread>{};
+			for (auto t = std::size_t{1}; t < threads_; ++t) {
+				workers.emplace_back(work, t);
+			}
+			work(0);
+			workers.clear();
+			if (state.error) {
+				std::rethrow_exception(state.error);
+			}
+		}
+
+		// the longest duration from the start of node to the end of the DAG
+		[[nodiscard]] auto priority(N const& node) const -> E {
+			auto const id = lengths_.snapshot().id_of(node);
+			if (not id) {
+				throw std::runtime_error("Cannot call gdwg::dag_executor<N, E>::priority on a node "
+				                         "that doesn't exist in the graph");
+			}
+			return lengths_.tail(*id);
+		}
+
+		[[nodiscard]] auto threads() const noexcept -> std::size_t {
+			return threads_;
+		}
+
+	private:
+		// priorities are the tails of the critical path analysis
+		static auto make_lengths(graph<N, E> const& g, std::size_t threads)
+		   -> detail::dag_lengths<N, E> {
+			auto c = detail::to_csr(g);
+			auto const order = detail::topological_order(c);
+			if (not order) {
+				throw std::runtime_error("Cannot create gdwg::dag_executor<N, E> from a graph with a "
+				                         "cycle");
+			}
+			return detail::dag_lengths<N, E>(std::move(c), *order, threads);
+		}
+
+		// the ready tasks of one worker, most urgent on top
+		struct ready_heap {
+			std::mutex mutex;
+			std::vector<std::pair<E, std::size_t>> tasks;
+		};
+
+		// what one run() shares between its workers
+		struct run_state {
+			explicit run_state(dag_executor const& owner)
+			: executor{owner}
+			, heaps(owner.threads_)
+			, waiting(owner.lengths_.snapshot().size())
+			, remaining{owner.lengths_.snapshot().size()} {
+				auto const n = owner.lengths_.snapshot().size();
+				auto next = std::size_t{0};
+				for (auto u = std::size_t{0}; u < n; ++u) {
+					waiting[u].store(owner.in_degree_[u], std::memory_order_relaxed);
+					if (owner.in_degree_[u] == 0) {
+						push(next, u);
+						next = (next + 1) % heaps.size();
+					}
+				}
+				if (n == 0) {
+					finish();
+				}
+			}
+
+			template<typename F>
+			auto work(std::size_t me, F& task) -> void {
+				auto const& c = executor.lengths_.snapshot();
+				while (remaining.load(std::memory_order_acquire) != 0) {
+					auto const u = pop(me);
+					if (not u) {
+						// sleeps until a task is queued or the run is over
+						available.wait(0, std::memory_order_acquire);
+						continue;
+					}
+					if (not cancelled.load(std::memory_order_relaxed)) {
+						try {
+							task(c.nodes[*u]);
+						} catch (...) {
+							auto const lock = std::lock_guard(error_mutex);
+							if (not error) {
+								error = std::current_exception();
+							}
+							cancelled.store(true, std::memory_order_relaxed);
+						}
+					}
+					for (auto e = c.offsets[*u]; e < c.offsets[*u + 1]; ++e) {
+						auto const v = c.targets[e];
+						if (waiting[v].fetch_sub(1, std::memory_order_acq_rel) == 1) {
+							push(me, v);
+						}
+					}
+					if (remaining.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+						finish();
+					}
+				}
+			}
+
+			auto push(std::size_t me, std::size_t u) -> void {
+				{
+					auto& heap = heaps[me];
+					auto const lock = std::lock_guard(heap.mutex);
+					heap.tasks.emplace_back(executor.lengths_.tail(u), u);
+					std::push_heap(heap.tasks.begin(), heap.tasks.end());
+					// counted under the lock, before a pop can take it ==> never below zero
+					available.fetch_add(1, std::memory_order_release);
+				}
+				available.notify_one();
+			}
+
+			// own heap first, then the others in turn
+			auto pop(std::size_t me) -> std::optional<std::size_t> {
+				for (auto i = std::size_t{0}; i < heaps.size(); ++i) {
+					auto& heap = heaps[(me + i) % heaps.size()];
+					auto const lock = std::lock_guard(heap.mutex);
+					if (not heap.tasks.empty()) {
+						std::pop_heap(heap.tasks.begin(), heap.tasks.end());
+						auto const u = heap.tasks.back().second;
+						heap.tasks.pop_back();
+						available.fetch_sub(1, std::memory_order_relaxed);
+						return u;
+					}
+				}
+				return std::nullopt;
+			}
+
+			// wakes every sleeping worker for good
+			auto finish() -> void {
+				available.fetch_add(1, std::memory_order_release);
+				available.notify_all();
+			}
+
+			dag_executor const& executor;
+			std::vector<ready_heap> heaps;
+			std::vector<std::atomic<std::size_t>> waiting;
+			std::atomic<std::size_t> remaining;
+			std::atomic<std::size_t> available = 0;
+			std::atomic<bool> cancelled = false;
+			std::mutex error_mutex;
+			std::exception_ptr error;
+		};
+
+		detail::dag_lengths<N, E> lengths_;
+		std::size_t threads_;
+		std::vector<std::size_t> in_degree_;
+	};
+} // namespace gdwg
+
+#endif // GDWG_DAG_EXECUTOR_HPP
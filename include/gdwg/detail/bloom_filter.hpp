@@ -0,0 +1,106 @@
+#ifndef GDWG_DETAIL_BLOOM_FILTER_HPP
+#define GDWG_DETAIL_BLOOM_FILTER_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace gdwg::detail {
+	// blocked (split-block) bloom filter over 64 bit hashes
+	// every key is mapped to one 64 byte block (= one cache line) and sets one bit in each of the
+	// 8 words of that block ==> a probe touches exactly one cache line. The 8 word loop has no
+	// data dependency between iterations so that the compiler can vectorise it
+	class blocked_bloom_filter {
+	public:
+		blocked_bloom_filter() noexcept = default;
+
+		// roughly 16 bits per expected key ==> false positive rate below 1%
+		explicit blocked_bloom_filter(std::size_t expected_keys)
+		: blocks_((expected_keys + keys_per_block - 1) / keys_per_block + 1)
+		, capacity_{blocks_.size() * keys_per_block} {}
+
+		auto insert(std::uint64_t hash) noexcept -> void {
+			auto& words = blocks_[block_index(hash)].words;
+			auto const masks = make_masks(hash);
+			for (auto i = std::size_t{0}; i < words_per_block; ++i) {
+				words[i] |= masks[i];
+			}
+		}
+
+		[[nodiscard]] auto may_contain(std::uint64_t hash) const noexcept -> bool {
+			auto const& words = blocks_[block_index(hash)].words;
+			auto const masks = make_masks(hash);
+			auto missing = std::uint64_t{0};
+			for (auto i = std::size_t{0}; i < words_per_block; ++i) {
+				missing |= masks[i] & ~words[i];
+			}
+			return missing == 0;
+		}
+
+		// keep the size of the filter but forget every key
+		auto clear() noexcept -> void {
+			for (auto& b : blocks_) {
+				b.words.fill(0);
+			}
+		}
+
+		// an empty filter is a disabled filter: it has no block to probe
+		[[nodiscard]] auto empty() const noexcept -> bool {
+			return blocks_.empty();
+		}
+
+		// number of keys the filter was sized for
+		[[nodiscard]] auto capacity() const noexcept -> std::size_t {
+			return capacity_;
+		}
+
+		// mix two addresses into one well distributed 64 bit hash (murmur3 finaliser)
+		[[nodiscard]] static auto hash_pair(void const* a, void const* b) noexcept -> std::uint64_t {
+			auto h = reinterpret_cast<std::uintptr_t>(a) * 0x9E3779B97F4A7C15ULL // NOLINT
+			         ^ reinterpret_cast<std::uintptr_t>(b); // NOLINT
+			h ^= h >> 33U;
+			h *= 0xFF51AFD7ED558CCDULL;
+			h ^= h >> 33U;
+			h *= 0xC4CEB9FE1A85EC53ULL;
+			h ^= h >> 33U;
+			return h;
+		}
+
+	private:
+		static constexpr auto words_per_block = std::size_t{8};
+		static constexpr auto keys_per_block = std::size_t{32};
+
+		struct alignas(64) block {
+			std::array<std::uint64_t, words_per_block> words = {};
+		};
+
+		// the high half of the hash picks the block, the low half picks one bit in every word
+		[[nodiscard]] auto block_index(std::uint64_t hash) const noexcept -> std::size_t {
+			return static_cast<std::size_t>(((hash >> 32U) * blocks_.size()) >> 32U);
+		}
+
+		[[nodiscard]] static auto make_masks(std::uint64_t hash) noexcept
+		   -> std::array<std::uint64_t, words_per_block> {
+			constexpr auto salt = std::array<std::uint32_t, words_per_block>{0x47b6137bU,
+			                                                                 0x44974d91U,
+			                                                                 0x8824ad5bU,
+			                                                                 0xa2b7289dU,
+			                                                                 0x705495c7U,
+			                                                                 0x2df1424bU,
+			                                                                 0x9efc4947U,
+			                                                                 0x5c6bfb31U};
+			auto const key = static_cast<std::uint32_t>(hash);
+			auto masks = std::array<std::uint64_t, words_per_block>{};
+			for (auto i = std::size_t{0}; i < words_per_block; ++i) {
+				masks[i] = std::uint64_t{1} << ((key * salt[i]) >> 26U);
+			}
+			return masks;
+		}
+
+		std::vector<block> blocks_;
+		std::size_t capacity_ = 0;
+	};
+} // namespace gdwg::detail
+
+#endif // GDWG_DETAIL_BLOOM_FILTER_HPP
@@ -0,0 +1,173 @@
+#ifndef GDWG_DETAIL_CSR_HPP
+#define GDWG_DETAIL_CSR_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <gdwg/graph.hpp>
+#include <optional>
+#include <vector>
+
+namespace gdwg::detail {
+	// a snapshot of a graph for whole-graph algorithms: nodes renumbered 0 .. n - 1 in ascending
+	// order, edges grouped by source in compressed sparse row form. The out-edges of u are
+	// targets[offsets[u] .. offsets[u + 1]) with their weights, in the iteration order of the graph
+	// ==> edge ids follow the order of graph<N, E>::iterator
+	template<typename N, typename E>
+	struct csr {
+		std::vector<N> nodes;
+		std::vector<std::size_t> offsets;
+		std::vector<std::size_t> targets;
+		std::vector<E> weights;
+
+		[[nodiscard]] auto size() const noexcept -> std::size_t {
+			return nodes.size();
+		}
+
+		[[nodiscard]] auto id_of(N const& value) const -> std::optional<std::size_t> {
+			auto const it = std::lower_bound(nodes.begin(), nodes.end(), value);
+			if (it == nodes.end() or not(*it == value)) {
+				return std::nullopt;
+			}
+			return static_cast<std::size_t>(it - nodes.begin());
+		}
+	};
+
+	// O(n + e log n)
+	template<typename N, typename E>
+	auto to_csr(graph<N, E> const& g) -> csr<N, E> {
+		auto result = csr<N, E>{g.nodes(), {}, {}, {}};
+		auto const n = result.size();
+		result.offsets.assign(n + 1, 0);
+		auto src = std::size_t{0};
+		for (auto const& [from, to, weight] : g) {
+			// edges come sorted by src ==> src only moves forward
+			while (not(result.nodes[src] == from)) {
+				++src;
+				result.offsets[src + 1] = result.offsets[src];
+			}
+			result.targets.push_back(*result.id_of(to));
+			result.weights.push_back(weight);
+			++result.offsets[src + 1];
+		}
+		for (auto u = src + 1; u < n; ++u) {
+			result.offsets[u + 1] = result.offsets[u];
+		}
+		return result;
+	}
+
+	// same nodes, every edge reversed. The in-edges of v are sorted by source
+	template<typename N, typename E>
+	auto transposed(csr<N, E> const& c) -> csr<N, E> {
+		auto const n = c.size();
+		auto result = csr<N, E>{c.nodes, std::vector<std::size_t>(n + 1, 0), {}, {}};
+		for (auto const v : c.targets) {
+			++result.offsets[v + 1];
+		}
+		for (auto v = std::size_t{0}; v < n; ++v) {
+			result.offsets[v + 1] += result.offsets[v];
+		}
+		result.targets.resize(c.targets.size());
+		result.weights.reserve(c.weights.size());
+		auto next = std::vector<std::size_t>(result.offsets.begin(), result.offsets.end() - 1);
+		auto edge_of = std::vector<std::size_t>(c.targets.size());
+		for (auto u = std::size_t{0}; u < n; ++u) {
+			for (auto e = c.offsets[u]; e < c.offsets[u + 1]; ++e) {
+				auto const slot = next[c.targets[e]]++;
+				result.targets[slot] = u;
+				edge_of[slot] = e;
+			}
+		}
+		for (auto const e : edge_of) {
+			result.weights.push_back(c.weights[e]);
+		}
+		return result;
+	}
+
+	// Kahn's algorithm ==> O(n + e). std::nullopt if there is a cycle
+	template<typename N, typename E>
+	auto topological_order(csr<N, E> const& c) -> std::optional<std::vector<std::size_t>> {
+		auto const n = c.size();
+		auto in_degree = std::vector<std::size_t>(n, 0);
+		for (auto const v : c.targets) {
+			++in_degree[v];
+		}
+		auto order = std::vector<std::size_t>{};
+		order.reserve(n);
+		for (auto u = std::size_t{0}; u < n; ++u) {
+			if (in_degree[u] == 0) {
+				order.push_back(u);
+			}
+		}
+		for (auto i = std::size_t{0}; i < order.size(); ++i) {
+			auto const u = order[i];
+			for (auto e = c.offsets[u]; e < c.offsets[u + 1]; ++e) {
+				if (--in_degree[c.targets[e]] == 0) {
+					order.push_back(c.targets[e]);
+				}
+			}
+		}
+		if (order.size() != n) {
+			return std::nullopt;
+		}
+		return order;
+	}
+
+	// the nodes of a DAG bucketed by level: the nodes of level k are
+	// items[offsets[k] .. offsets[k + 1]), in topological order within a level
+	struct levels {
+		std::vector<std::size_t> items;
+		std::vector<std::size_t> offsets;
+	};
+
+	inline auto bucket_by_level(std::vector<std::size_t> const& level_of,
+	                            std::size_t max_level,
+	                            std::vector<std::size_t> const& order) -> levels {
+		auto result =
+		   levels{std::vector<std::size_t>(order.size()), std::vector<std::size_t>(max_level + 2, 0)};
+		for (auto const level : level_of) {
+			++result.offsets[level + 1];
+		}
+		for (auto k = std::size_t{0}; k + 1 < result.offsets.size(); ++k) {
+			result.offsets[k + 1] += result.offsets[k];
+		}
+		auto next = std::vector<std::size_t>(result.offsets.begin(), result.offsets.end() - 1);
+		for (auto const u : order) {
+			result.items[next[level_of[u]]++] = u;
+		}
+		return result;
+	}
+
+	// level = number of edges of the longest path reaching the node ==> a node only depends on
+	// its predecessors, all in lower levels
+	template<typename N, typename E>
+	auto depth_levels(csr<N, E> const& c, std::vector<std::size_t> const& order) -> levels {
+		auto depth = std::vector<std::size_t>(c.size(), 0);
+		auto max_depth = std::size_t{0};
+		for (auto const u : order) {
+			for (auto e = c.offsets[u]; e < c.offsets[u + 1]; ++e) {
+				auto& d = depth[c.targets[e]];
+				d = std::max(d, depth[u] + 1);
+				max_depth = std::max(max_depth, d);
+			}
+		}
+		return bucket_by_level(depth, max_depth, order);
+	}
+
+	// level = number of edges of the longest path leaving the node ==> a node only depends on
+	// its successors, all in lower levels
+	template<typename N, typename E>
+	auto height_levels(csr<N, E> const& c, std::vector<std::size_t> const& order) -> levels {
+		auto height = std::vector<std::size_t>(c.size(), 0);
+		auto max_height = std::size_t{0};
+		for (auto i = order.rbegin(); i != order.rend(); ++i) {
+			auto const u = *i;
+			for (auto e = c.offsets[u]; e < c.offsets[u + 1]; ++e) {
+				height[u] = std::max(height[u], height[c.targets[e]] + 1);
+			}
+			max_height = std::max(max_height, height[u]);
+		}
+		return bucket_by_level(height, max_height, order);
+	}
+} // namespace gdwg::detail
+
+#endif // GDWG_DETAIL_CSR_HPP
@@ -0,0 +1,90 @@
+#ifndef GDWG_DETAIL_LRU_CACHE_HPP
+#define GDWG_DETAIL_LRU_CACHE_HPP
+
+#include <cstddef>
+#include <functional>
+#include <list>
+#include <map>
+#include <utility>
+
+namespace gdwg::detail {
+	// bounded least-recently-used cache
+	// std::list keeps the recency order (front = most recent), std::map indexes the list nodes.
+	// Compare may be transparent, in which case erase(k) drops every key equivalent to k: this is
+	// how a whole group of keys (e.g. every (src, dst) pair of one src) is invalidated at once
+	template<typename Key, typename Value, typename Compare = std::less<>>
+	class lru_cache {
+	public:
+		lru_cache() noexcept = default;
+
+		explicit lru_cache(std::size_t capacity) noexcept
+		: capacity_{capacity} {}
+
+		// the index holds iterators into entries_: a copy would point into the list of the
+		// original. Moving a std::list keeps its nodes ==> the moved index stays valid
+		lru_cache(lru_cache const&) = delete;
+		auto operator=(lru_cache const&) -> lru_cache& = delete;
+		lru_cache(lru_cache&&) noexcept = default;
+		auto operator=(lru_cache&&) noexcept -> lru_cache& = default;
+		~lru_cache() = default;
+
+		// nullptr on a miss. A hit becomes the most recently used entry
+		[[nodiscard]] auto get(Key const& key) -> Value const* {
+			auto const it = index_.find(key);
+			if (it == index_.end()) {
+				return nullptr;
+			}
+			entries_.splice(entries_.begin(), entries_, it->second);
+			return &it->second->second;
+		}
+
+		auto put(Key const& key, Value value) -> void {
+			if (capacity_ == 0) {
+				return;
+			}
+			if (auto const it = index_.find(key); it != index_.end()) {
+				it->second->second = std::move(value);
+				entries_.splice(entries_.begin(), entries_, it->second);
+				return;
+			}
+			if (entries_.size() == capacity_) {
+				index_.erase(entries_.back().first);
+				entries_.pop_back();
+			}
+			entries_.emplace_front(key, std::move(value));
+			index_.emplace(key, entries_.begin());
+		}
+
+		template<typename K>
+		auto erase(K const& key) -> void {
+			auto const [first, last] = index_.equal_range(key);
+			for (auto it = first; it != last; ++it) {
+				entries_.erase(it->second);
+			}
+			index_.erase(first, last);
+		}
+
+		auto clear() noexcept -> void {
+			index_.clear();
+			entries_.clear();
+		}
+
+		[[nodiscard]] auto size() const noexcept -> std::size_t {
+			return entries_.size();
+		}
+
+		// a cache of capacity 0 is disabled: put() is a no-op and get() always misses
+		[[nodiscard]] auto capacity() const noexcept -> std::size_t {
+			return capacity_;
+		}
+
+	private:
+		using list_type = std::list<std::pair<Key, Value>>;
+
+		std::size_t capacity_ = 0;
+		list_type entries_;
+		std::map<Key, typename list_type::iterator, Compare> index_;
+	};
+} // namespace gdwg::detail
+
+#endif // GDWG_DETAIL_LRU_CACHE_HPP
@@ -0,0 +1,87 @@
+#ifndef GDWG_DETAIL_PARALLEL_HPP
+#define GDWG_DETAIL_PARALLEL_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <barrier>
+#include <cstddef>
+#include <gdwg/detail/csr.hpp>
+#include <thread>
+#include <vector>
+
+namespace gdwg::detail {
+	// requested threads, 0 meaning one per core, and never more than useful for work items
+	inline auto thread_count(std::size_t requested, std::size_t work) -> std::size_t {
+		auto const threads =
+		   requested == 0 ? std::size_t{std::thread::hardware_concurrency()} : requested;
+		return std::clamp(threads, std::size_t{1}, std::max(work, std::size_t{1}));
+	}
+
+	// f(item) for every item of level 0, then of level 1, ...: the items of one level run in
+	// parallel on threads threads, picked in small batches, with a barrier between two levels.
+	// f must not throw
+	template<typename F>
+	auto for_each_level(levels const& l, std::size_t threads, F const& f) -> void {
+		auto const num_levels = l.offsets.size() - 1;
+		if (threads <= 1) {
+			for (auto const item : l.items) {
+				f(item);
+			}
+			return;
+		}
+		constexpr auto grain = std::size_t{16};
+		auto level = std::size_t{0};
+		auto next = std::atomic<std::size_t>{l.offsets[0]};
+		// runs once all threads arrived ==> every thread sees the new level after the barrier
+		auto const advance = [&]() noexcept {
+			++level;
+			if (level < num_levels) {
+				next.store(l.offsets[level], std::memory_order_relaxed);
+			}
+		};
+		auto sync = std::barrier(static_cast<std::ptrdiff_t>(threads), advance);
+		auto const work = [&] {
+			while (level < num_levels) {
+				auto const last = l.offsets[level + 1];
+				for (auto i = next.fetch_add(grain, std::memory_order_relaxed); i < last;
+				     i = next.fetch_add(grain, std::memory_order_relaxed)) {
+					for (auto j = i; j < std::min(i + grain, last); ++j) {
+						f(l.items[j]);
+					}
+				}
+				sync.arrive_and_wait();
+			}
+		};
+		auto workers = std::vector<std::jthread>{};
+		for (auto t = std::size_t{1}; t < threads; ++t) {
+			workers.emplace_back(work);
+		}
+		work();
+	}
+
+	// f(i, worker) for every i in [0, count) on threads threads, one i at a time. worker in
+	// [0, threads) names the calling thread, for scratch space of its own. f must not throw
+	template<typename F>
+	auto for_each_index(std::size_t count, std::size_t threads, F const& f) -> void {
+		if (threads <= 1) {
+			for (auto i = std::size_t{0}; i < count; ++i) {
+				f(i, std::size_t{0});
+			}
+			return;
+		}
+		auto next = std::atomic<std::size_t>{0};
+		auto const work = [&](std::size_t worker) {
+			for (auto i = next.fetch_add(1, std::memory_order_relaxed); i < count;
+			     i = next.fetch_add(1, std::memory_order_relaxed)) {
+				f(i, worker);
+			}
+		};
+		auto workers = std::vector<std::jthread>{};
+		for (auto t = std::size_t{1}; t < threads; ++t) {
+			workers.emplace_back(work, t);
+		}
+		work(0);
+	}
+} // namespace gdwg::detail
+
+#endif // GDWG_DETAIL_PARALLEL_HPP
@@ -0,0 +1,98 @@
+#ifndef GDWG_DIFF_HPP
+#define GDWG_DIFF_HPP
+
+#include <algorithm>
+#include <gdwg/graph.hpp>
+#include <iterator>
+#include <tuple>
+#include <vector>
+
+namespace gdwg {
+	// the mutations turning one graph into another, every list sorted.
+	// Edges touching an erased node are not listed: erasing the node already erases them
+	template<typename N, typename E>
+	struct graph_diff {
+		std::vector<N> erased_nodes;
+		std::vector<N> inserted_nodes;
+		std::vector<typename graph<N, E>::value_type> erased_edges;
+		std::vector<typename graph<N, E>::value_type> inserted_edges;
+
+		[[nodiscard]] auto empty() const noexcept -> bool {
+			return erased_nodes.empty() and inserted_nodes.empty() and erased_edges.empty()
+			       and inserted_edges.empty();
+		}
+	};
+
+	// merge walk of the sorted nodes and of the sorted edges of a and b ==> O(n + e log n)
+	template<typename N, typename E>
+	[[nodiscard]] auto diff(graph<N, E> const& a, graph<N, E> const& b) -> graph_diff<N, E> {
+		auto result = graph_diff<N, E>{};
+		auto const nodes_a = a.nodes();
+		auto const nodes_b = b.nodes();
+		std::set_difference(nodes_a.begin(),
+		                    nodes_a.end(),
+		                    nodes_b.begin(),
+		                    nodes_b.end(),
+		                    std::back_inserter(result.erased_nodes));
+		std::set_difference(nodes_b.begin(),
+		                    nodes_b.end(),
+		                    nodes_a.begin(),
+		                    nodes_a.end(),
+		                    std::back_inserter(result.inserted_nodes));
+
+		auto const is_erased = [&erased = result.erased_nodes](N const& value) {
+			return std::binary_search(erased.begin(), erased.end(), value);
+		};
+		auto it_a = a.begin();
+		auto it_b = b.begin();
+		while (it_a != a.end() or it_b != b.end()) {
+			if (it_b == b.end()) {
+				auto const& [from, to, weight] = *it_a++;
+				if (not is_erased(from) and not is_erased(to)) {
+					result.erased_edges.push_back({from, to, weight});
+				}
+				continue;
+			}
+			if (it_a == a.end()) {
+				auto const& [from, to, weight] = *it_b++;
+				result.inserted_edges.push_back({from, to, weight});
+				continue;
+			}
+			auto const& [from_a, to_a, weight_a] = *it_a;
+			auto const& [from_b, to_b, weight_b] = *it_b;
+			auto const edge_a = std::tie(from_a, to_a, weight_a);
+			auto const edge_b = std::tie(from_b, to_b, weight_b);
+			if (edge_a < edge_b) {
+				if (not is_erased(from_a) and not is_erased(to_a)) {
+					result.erased_edges.push_back({from_a, to_a, weight_a});
+				}
+				++it_a;
+			}
+			else if (edge_b < edge_a) {
+				result.inserted_edges.push_back({from_b, to_b, weight_b});
+				++it_b;
+			}
+			else {
+				++it_a;
+				++it_b;
+			}
+		}
+		return result;
+	}
+
+	// replays d on g in one batch per list: the erased nodes, the erased edges, the new nodes,
+	// then the new edges. The edge lists are sorted like the edges of g, so graph<N, E>::erase_edges
+	// and insert_edges find almost every edge next to the previous one. After apply(a, diff(a, b)),
+	// a == b
+	template<typename N, typename E>
+	auto apply(graph<N, E>& g, graph_diff<N, E> const& d) -> void {
+		g.erase_nodes(d.erased_nodes);
+		g.erase_edges(d.erased_edges);
+		for (auto const& value : d.inserted_nodes) {
+			g.insert_node(value);
+		}
+		g.insert_edges(d.inserted_edges);
+	}
+} // namespace gdwg
+
+#endif // GDWG_DIFF_HPP
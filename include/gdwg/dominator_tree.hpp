@@ -0,0 +1,257 @@
+#ifndef GDWG_DOMINATOR_TREE_HPP
+#define GDWG_DOMINATOR_TREE_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <gdwg/detail/csr.hpp>
+#include <gdwg/graph.hpp>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace gdwg {
+	// a dominates b if every path from the entry to b goes through a. The immediate dominator of
+	// b is its closest strict dominator, its parent in the dominator tree.
+	//
+	// Cooper, Harvey and Kennedy's iterative algorithm: the nodes reachable from the entry are
+	// renumbered in reverse postorder and each one's immediate dominator is the intersection of
+	// the dominator tree paths of its predecessors, repeated until nothing changes (twice for
+	// reducible control flow graphs). All arrays are indexed by reverse postorder, so the
+	// intersections walk contiguous memory. The tree is then numbered in preorder and postorder
+	// so that dominates(a, b) is O(log n), the lookups of a and b.
+	//
+	// The tree is a snapshot: later changes of the graph are not reflected
+	template<typename N>
+	class dominator_tree {
+	public:
+		template<typename E>
+		dominator_tree(graph<N, E> const& g, N const& entry)
+		: dominator_tree(detail::to_csr(g), entry) {}
+
+		// on a snapshot of the graph, see post_dominator_tree
+		template<typename E>
+		dominator_tree(detail::csr<N, E> const& c, N const& entry) {
+			auto const root = c.id_of(entry);
+			if (not root) {
+				throw std::runtime_error("Cannot create gdwg::dominator_tree<N> from an entry that "
+				                         "doesn't exist in the graph");
+			}
+			nodes_ = c.nodes;
+			number_reachable(c, *root);
+			compute_idoms(c);
+			number_tree();
+		}
+
+		[[nodiscard]] auto entry() const -> N const& {
+			return nodes_[order_[0]];
+		}
+
+		// whether there is a path from the entry to node. The other nodes have no dominator
+		[[nodiscard]] auto is_reachable(N const& node) const -> bool {
+			return rpo_of(node, "is_reachable") != npos;
+		}
+
+		// std::nullopt for the entry and for unreachable nodes
+		[[nodiscard]] auto immediate_dominator(N const& node) const -> std::optional<N> {
+			auto const b = rpo_of(node, "immediate_dominator");
+			if (b == npos or b == 0) {
+				return std::nullopt;
+			}
+			return nodes_[order_[idom_[b]]];
+		}
+
+		// every node dominates itself. false if either node is unreachable
+		[[nodiscard]] auto dominates(N const& a, N const& b) const -> bool {
+			auto const x = rpo_of(a, "dominates");
+			auto const y = rpo_of(b, "dominates");
+			if (x == npos or y == npos) {
+				return false;
+			}
+			return pre_[x] <= pre_[y] and post_[y] <= post_[x];
+		}
+
+		// the nodes node immediately dominates, in ascending order
+		[[nodiscard]] auto children(N const& node) const -> std::vector<N> {
+			auto const b = rpo_of(node, "children");
+			auto result = std::vector<N>{};
+			if (b == npos) {
+				return result;
+			}
+			for (auto i = child_offsets_[b]; i < child_offsets_[b + 1]; ++i) {
+				result.push_back(nodes_[order_[children_[i]]]);
+			}
+			std::sort(result.begin(), result.end());
+			return result;
+		}
+
+	private:
+		static constexpr auto npos = static_cast<std::size_t>(-1);
+
+		// reverse postorder of an iterative depth first search from root
+		template<typename E>
+		auto number_reachable(detail::csr<N, E> const& c, std::size_t root) -> void {
+			rpo_.assign(c.size(), npos);
+			auto visited = std::vector<bool>(c.size(), false);
+			// (node, next out-edge to follow)
+			auto stack = std::vector<std::pair<std::size_t, std::size_t>>{{root, c.offsets[root]}};
+			visited[root] = true;
+			while (not stack.empty()) {
+				auto& [u, e] = stack.back();
+				if (e == c.offsets[u + 1]) {
+					order_.push_back(u);
+					stack.pop_back();
+					continue;
+				}
+				auto const v = c.targets[e++];
+				if (not visited[v]) {
+					visited[v] = true;
+					stack.emplace_back(v, c.offsets[v]);
+				}
+			}
+			std::reverse(order_.begin(), order_.end());
+			for (auto i = std::size_t{0}; i < order_.size(); ++i) {
+				rpo_[order_[i]] = i;
+			}
+		}
+
+		template<typename E>
+		auto compute_idoms(detail::csr<N, E> const& c) -> void {
+			auto const n = order_.size();
+			// predecessors in reverse postorder numbers, unreachable ones left out
+			auto pred_offsets = std::vector<std::size_t>(n + 1, 0);
+			for (auto u = std::size_t{0}; u < c.size(); ++u) {
+				if (rpo_[u] == npos) {
+					continue;
+				}
+				for (auto e = c.offsets[u]; e < c.offsets[u + 1]; ++e) {
+					++pred_offsets[rpo_[c.targets[e]] + 1];
+				}
+			}
+			for (auto b = std::size_t{0}; b < n; ++b) {
+				pred_offsets[b + 1] += pred_offsets[b];
+			}
+			auto preds = std::vector<std::size_t>(pred_offsets[n]);
+			auto next = std::vector<std::size_t>(pred_offsets.begin(), pred_offsets.end() - 1);
+			for (auto u = std::size_t{0}; u < c.size(); ++u) {
+				if (rpo_[u] == npos) {
+					continue;
+				}
+				for (auto e = c.offsets[u]; e < c.offsets[u + 1]; ++e) {
+					preds[next[rpo_[c.targets[e]]]++] = rpo_[u];
+				}
+			}
+
+			idom_.assign(n, npos);
+			if (n == 0) {
+				return;
+			}
+			idom_[0] = 0;
+			for (auto changed = true; changed;) {
+				changed = false;
+				for (auto b = std::size_t{1}; b < n; ++b) {
+					auto new_idom = npos;
+					for (auto i = pred_offsets[b]; i < pred_offsets[b + 1]; ++i) {
+						auto const p = preds[i];
+						if (idom_[p] == npos) {
+							continue;
+						}
+						new_idom = new_idom == npos ? p : intersect(p, new_idom);
+					}
+					if (idom_[b] != new_idom) {
+						idom_[b] = new_idom;
+						changed = true;
+					}
+				}
+			}
+		}
+
+		// the closest common ancestor of a and b in the tree built so far. A parent always has a
+		// smaller number than its children
+		auto intersect(std::size_t a, std::size_t b) const -> std::size_t {
+			while (a != b) {
+				while (a > b) {
+					a = idom_[a];
+				}
+				while (b > a) {
+					b = idom_[b];
+				}
+			}
+			return a;
+		}
+
+		// children lists, then preorder / postorder numbers of an iterative traversal
+		auto number_tree() -> void {
+			auto const n = order_.size();
+			child_offsets_.assign(n + 1, 0);
+			for (auto b = std::size_t{1}; b < n; ++b) {
+				++child_offsets_[idom_[b] + 1];
+			}
+			for (auto b = std::size_t{0}; b < n; ++b) {
+				child_offsets_[b + 1] += child_offsets_[b];
+			}
+			children_.resize(n == 0 ? 0 : n - 1);
+			auto next = std::vector<std::size_t>(child_offsets_.begin(), child_offsets_.end() - 1);
+			for (auto b = std::size_t{1}; b < n; ++b) {
+				children_[next[idom_[b]]++] = b;
+			}
+
+			pre_.assign(n, 0);
+			post_.assign(n, 0);
+			if (n == 0) {
+				return;
+			}
+			auto counter = std::size_t{0};
+			auto stack = std::vector<std::pair<std::size_t, std::size_t>>{{0, child_offsets_[0]}};
+			pre_[0] = counter++;
+			while (not stack.empty()) {
+				auto& [b, i] = stack.back();
+				if (i == child_offsets_[b + 1]) {
+					post_[b] = counter++;
+					stack.pop_back();
+					continue;
+				}
+				auto const child = children_[i++];
+				pre_[child] = counter++;
+				stack.emplace_back(child, child_offsets_[child]);
+			}
+		}
+
+		auto rpo_of(N const& node, char const* caller) const -> std::size_t {
+			auto const it = std::lower_bound(nodes_.begin(), nodes_.end(), node);
+			if (it == nodes_.end() or not(*it == node)) {
+				throw std::runtime_error(std::string("Cannot call gdwg::dominator_tree<N>::") + caller
+				                         + " on a node that doesn't exist in the graph");
+			}
+			return rpo_[static_cast<std::size_t>(it - nodes_.begin())];
+		}
+
+		// by id
+		std::vector<N> nodes_;
+		std::vector<std::size_t> rpo_;
+		// by reverse postorder number
+		std::vector<std::size_t> order_;
+		std::vector<std::size_t> idom_;
+		std::vector<std::size_t> child_offsets_;
+		std::vector<std::size_t> children_;
+		std::vector<std::size_t> pre_;
+		std::vector<std::size_t> post_;
+	};
+
+	template<typename N, typename E>
+	dominator_tree(graph<N, E> const&, N const&) -> dominator_tree<N>;
+
+	// a post-dominates b if every path from b to the exit goes through a: the dominator tree of
+	// the graph with every edge reversed, rooted at the exit
+	template<typename N, typename E>
+	auto post_dominator_tree(graph<N, E> const& g, N const& exit) -> dominator_tree<N> {
+		if (not g.is_node(exit)) {
+			throw std::runtime_error("Cannot create gdwg::post_dominator_tree from an exit that "
+			                         "doesn't exist in the graph");
+		}
+		return dominator_tree<N>(detail::transposed(detail::to_csr(g)), exit);
+	}
+} // namespace gdwg
+
+#endif // GDWG_DOMINATOR_TREE_HPP
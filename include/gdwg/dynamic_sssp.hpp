@@ -0,0 +1,258 @@
+#ifndef GDWG_DYNAMIC_SSSP_HPP
+#define GDWG_DYNAMIC_SSSP_HPP
+
+#include <functional>
+#include <gdwg/graph.hpp>
+#include <map>
+#include <optional>
+#include <queue>
+#include <set>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace gdwg {
+	// single source shortest paths kept up to date while edges of the attached graph change.
+	// Edge weights are the lengths (non-negative, arithmetic E).
+	//
+	// Every edge change must go through insert_edge() / erase_edge() / update_weight() below:
+	// they forward to the graph and then repair only the part of the shortest path tree that the
+	// change can affect (Ramalingam-Reps):
+	//   insertion: Dijkstra restarted from dst, stopping where distances don't improve
+	//   deletion:  only when the edge is the tree edge of dst, the subtree below dst is detached and
+	//              re-attached by a Dijkstra seeded from its unaffected in-neighbours
+	// Nodes may be inserted into the graph directly (a new node is unreachable). After any other
+	// direct change of the graph, call recompute()
+	template<typename N, typename E>
+	requires std::is_arithmetic_v<E> class dynamic_sssp {
+	public:
+		dynamic_sssp(graph<N, E>& g, N const& source)
+		: graph_{&g}
+		, source_{source} {
+			if (not g.is_node(source)) {
+				throw std::runtime_error("Cannot create gdwg::dynamic_sssp<N, E> from a source that "
+				                         "doesn't exist in the graph");
+			}
+			recompute();
+		}
+
+		auto insert_edge(N const& src, N const& dst, E const& weight) -> bool {
+			if (weight < E{}) {
+				throw std::runtime_error("Cannot call gdwg::dynamic_sssp<N, E>::insert_edge with a "
+				                         "negative weight");
+			}
+			if (not graph_->insert_edge(src, dst, weight)) {
+				return false;
+			}
+			auto& pair_weight = out_[src].try_emplace(dst, weight).first->second;
+			if (weight < pair_weight) {
+				pair_weight = weight;
+			}
+			in_[dst][src] = pair_weight;
+
+			relax(src, dst, pair_weight);
+			return true;
+		}
+
+		auto erase_edge(N const& src, N const& dst, E const& weight) -> bool {
+			if (not graph_->erase_edge(src, dst, weight)) {
+				return false;
+			}
+			pair_changed(src, dst);
+			return true;
+		}
+
+		// the edge is updated in place in the graph (graph::update_weight), then the lighter weight
+		// is relaxed or the heavier one repaired like a deletion
+		auto update_weight(N const& src, N const& dst, E const& old_weight, E const& new_weight)
+		   -> bool {
+			if (new_weight < E{}) {
+				throw std::runtime_error("Cannot call gdwg::dynamic_sssp<N, E>::update_weight with a "
+				                         "negative weight");
+			}
+			if (not graph_->update_weight(src, dst, old_weight, new_weight)) {
+				return false;
+			}
+			pair_changed(src, dst);
+			return true;
+		}
+
+		// distance from source(), or std::nullopt if node is unreachable
+		[[nodiscard]] auto distance(N const& node) const -> std::optional<E> {
+			auto const it = dist_.find(node);
+			if (it == dist_.end()) {
+				return std::nullopt;
+			}
+			return it->second;
+		}
+
+		[[nodiscard]] auto source() const noexcept -> N const& {
+			return source_;
+		}
+
+		[[nodiscard]] auto get_graph() const noexcept -> graph<N, E> const& {
+			return *graph_;
+		}
+
+		// rebuild the adjacency and all distances from scratch: O(e log(e))
+		auto recompute() -> void {
+			out_.clear();
+			in_.clear();
+			for (auto const& [from, to, weight] : *graph_) {
+				if (weight < E{}) {
+					throw std::runtime_error("Cannot use gdwg::dynamic_sssp<N, E> on a graph with "
+					                         "negative weights");
+				}
+				// edges are sorted by (src, dst, weight) ==> the first one of a pair is the lightest
+				out_[from].try_emplace(to, weight);
+				in_[to].try_emplace(from, weight);
+			}
+			dist_.clear();
+			parent_.clear();
+			dist_.emplace(source_, E{});
+			auto queue = frontier_type{};
+			queue.emplace(E{}, source_);
+			propagate(queue, nullptr);
+		}
+
+	private:
+		using frontier_type = std::priority_queue<std::pair<E, N>,
+		                                          std::vector<std::pair<E, N>>,
+		                                          std::greater<std::pair<E, N>>>;
+
+		// the (src, dst) pair now has a lighter edge: improve dst and everything behind it
+		auto relax(N const& src, N const& dst, E const& weight) -> void {
+			auto const it_src = dist_.find(src);
+			if (it_src == dist_.end()) {
+				return;
+			}
+			auto const candidate = it_src->second + weight;
+			if (auto const it_dst = dist_.find(dst);
+			    it_dst != dist_.end() and it_dst->second <= candidate) {
+				return;
+			}
+			dist_.insert_or_assign(dst, candidate);
+			parent_.insert_or_assign(dst, src);
+			auto queue = frontier_type{};
+			queue.emplace(candidate, dst);
+			propagate(queue, nullptr);
+		}
+
+		// the edges of the (src, dst) pair were erased or re-weighted in the graph: re-read the
+		// lightest one, which is the only one shortest paths can use, and fix the distances
+		auto pair_changed(N const& src, N const& dst) -> void {
+			auto const remaining = graph_->weights(src, dst);
+			if (remaining.empty()) {
+				out_[src].erase(dst);
+				in_[dst].erase(src);
+			}
+			else {
+				out_[src][dst] = remaining.front();
+				in_[dst][src] = remaining.front();
+				relax(src, dst, remaining.front());
+			}
+
+			auto const it_parent = parent_.find(dst);
+			if (it_parent == parent_.end() or it_parent->second != src) {
+				return;
+			}
+			if (not remaining.empty() and dist_.at(src) + remaining.front() == dist_.at(dst)) {
+				return;
+			}
+			repair_subtree(dst);
+		}
+
+		// Dijkstra from the nodes already in queue (whose dist_ is set). If `within` is given,
+		// only the nodes of that set may still change
+		auto propagate(frontier_type& queue, std::set<N> const* within) -> void {
+			while (not queue.empty()) {
+				auto [d, node] = queue.top();
+				queue.pop();
+				if (dist_.at(node) < d) {
+					continue;
+				}
+				auto const it_out = out_.find(node);
+				if (it_out == out_.end()) {
+					continue;
+				}
+				for (auto const& [next, weight] : it_out->second) {
+					if (within != nullptr and not within->count(next)) {
+						continue;
+					}
+					auto const candidate = d + weight;
+					auto const it_next = dist_.find(next);
+					if (it_next != dist_.end() and it_next->second <= candidate) {
+						continue;
+					}
+					dist_.insert_or_assign(next, candidate);
+					parent_.insert_or_assign(next, node);
+					queue.emplace(candidate, next);
+				}
+			}
+		}
+
+		// root lost its tree edge: forget the distances of its subtree, then reconnect the subtree
+		// through the best edge coming from outside of it
+		auto repair_subtree(N const& root) -> void {
+			auto affected = std::set<N>{root};
+			auto pending = std::vector<N>{root};
+			while (not pending.empty()) {
+				auto const node = pending.back();
+				pending.pop_back();
+				auto const it_out = out_.find(node);
+				if (it_out == out_.end()) {
+					continue;
+				}
+				for (auto const& [child, weight] : it_out->second) {
+					auto const it_parent = parent_.find(child);
+					if (it_parent != parent_.end() and it_parent->second == node
+					    and affected.insert(child).second) {
+						pending.push_back(child);
+					}
+				}
+			}
+			for (auto const& node : affected) {
+				dist_.erase(node);
+				parent_.erase(node);
+			}
+
+			auto queue = frontier_type{};
+			for (auto const& node : affected) {
+				auto const it_in = in_.find(node);
+				if (it_in == in_.end()) {
+					continue;
+				}
+				for (auto const& [prev, weight] : it_in->second) {
+					auto const it_prev = dist_.find(prev);
+					if (it_prev == dist_.end()) {
+						continue;
+					}
+					auto const candidate = it_prev->second + weight;
+					auto const it_node = dist_.find(node);
+					if (it_node == dist_.end() or candidate < it_node->second) {
+						dist_.insert_or_assign(node, candidate);
+						parent_.insert_or_assign(node, prev);
+					}
+				}
+				if (auto const it_node = dist_.find(node); it_node != dist_.end()) {
+					queue.emplace(it_node->second, node);
+				}
+			}
+			propagate(queue, &affected);
+		}
+
+		graph<N, E>* graph_;
+		N source_;
+
+		// lightest weight of every connected (src, dst) pair, by src and by dst
+		std::map<N, std::map<N, E>> out_;
+		std::map<N, std::map<N, E>> in_;
+
+		// only reachable nodes have a distance. The source is the only one without a parent
+		std::map<N, E> dist_;
+		std::map<N, N> parent_;
+	};
+} // namespace gdwg
+
+#endif // GDWG_DYNAMIC_SSSP_HPP
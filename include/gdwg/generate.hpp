@@ -0,0 +1,279 @@
+#ifndef GDWG_GENERATE_HPP
+#define GDWG_GENERATE_HPP
+
+#include <algorithm>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <gdwg/graph.hpp>
+#include <limits>
+#include <random>
+#include <stdexcept>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+// synthetic graphs for benchmarks and load tests. Every generator returns the edges as a
+// std::vector<graph<N, E>::value_type>, ready for the range constructor of gdwg::graph:
+//     auto const edges = gdwg::generate::rmat<int, int>({.scale = 16, .edge_factor = 8});
+//     auto const g = gdwg::graph<int, int>(edges.begin(), edges.end());
+// Nodes are 0 .. n - 1, weights are uniform in [1, max_weight]. Nodes without any edge are not
+// in the stream. The same parameters and seed always give the same stream, whatever the number of
+// threads: the work is cut into fixed chunks, each chunk has its own engine seeded from
+// (seed, chunk index), and the chunks are concatenated in order.
+namespace gdwg::generate {
+	template<typename N, typename E>
+	using edge_list = std::vector<typename graph<N, E>::value_type>;
+
+	// 0 ==> std::thread::hardware_concurrency()
+	struct execution {
+		std::size_t threads = 0;
+	};
+
+	namespace detail {
+		inline constexpr auto chunk_size = std::size_t{1} << 14U;
+
+		inline auto chunk_engine(std::uint64_t seed, std::size_t chunk) -> std::mt19937_64 {
+			auto sequence = std::seed_seq{static_cast<std::uint32_t>(seed),
+			                              static_cast<std::uint32_t>(seed >> 32U),
+			                              static_cast<std::uint32_t>(chunk),
+			                              static_cast<std::uint32_t>(chunk >> 32U)};
+			return std::mt19937_64(sequence);
+		}
+
+		// checked before any thread starts
+		template<typename E>
+		auto check_max_weight(E max_weight) -> void {
+			if (not(E{1} <= max_weight)) {
+				throw std::invalid_argument("gdwg::generate: max_weight must be at least 1");
+			}
+		}
+
+		template<typename E>
+		requires std::is_arithmetic_v<E> auto weight_distribution(E max_weight) {
+			if constexpr (std::is_integral_v<E>) {
+				return std::uniform_int_distribution<E>(E{1}, max_weight);
+			}
+			else {
+				return std::uniform_real_distribution<E>(E{1}, max_weight);
+			}
+		}
+
+		// runs make_chunk(engine, chunk, out) for chunk = 0 .. chunks - 1 on up to threads threads
+		// and concatenates the outputs in chunk order
+		template<typename Edge, typename F>
+		auto run_chunks(std::size_t chunks, std::uint64_t seed, execution policy, F make_chunk)
+		   -> std::vector<Edge> {
+			auto parts = std::vector<std::vector<Edge>>(chunks);
+			auto threads = policy.threads == 0 ? std::thread::hardware_concurrency() : policy.threads;
+			threads = std::clamp(threads, std::size_t{1}, std::max(chunks, std::size_t{1}));
+			auto const work = [&](std::size_t first) {
+				for (auto chunk = first; chunk < chunks; chunk += threads) {
+					auto engine = chunk_engine(seed, chunk);
+					make_chunk(engine, chunk, parts[chunk]);
+				}
+			};
+			auto workers = std::vector<std::jthread>{};
+			for (auto t = std::size_t{1}; t < threads; ++t) {
+				workers.emplace_back(work, t);
+			}
+			work(0);
+			workers.clear(); // joins
+
+			auto total = std::size_t{0};
+			for (auto const& part : parts) {
+				total += part.size();
+			}
+			auto result = std::vector<Edge>{};
+			result.reserve(total);
+			for (auto& part : parts) {
+				result.insert(result.end(), part.begin(), part.end());
+			}
+			return result;
+		}
+	} // namespace detail
+
+	struct rmat_parameters {
+		unsigned scale = 10; // 2^scale nodes
+		std::size_t edge_factor = 16; // edge_factor * 2^scale edges
+		double a = 0.57;
+		double b = 0.19;
+		double c = 0.19; // d = 1 - a - b - c
+		std::uint64_t seed = 6771;
+	};
+
+	// R-MAT (Chakrabarti et al.), the Graph500 Kronecker generator: each edge picks one quadrant of
+	// the adjacency matrix per bit of the node ids, giving a skewed, power law like degree
+	// distribution. Duplicate edges are possible: graph<N, E> keeps the ones with the same weight
+	// once, and the ones with different weights as parallel edges between the same nodes
+	template<std::integral N, typename E>
+	requires std::is_arithmetic_v<E> //
+	   auto rmat(rmat_parameters const& p, E max_weight = E{100}, execution policy = {})
+	      -> edge_list<N, E> {
+		if (p.scale >= static_cast<unsigned>(std::numeric_limits<N>::digits)
+		    or p.a < 0 or p.b < 0 or p.c < 0 or p.a + p.b + p.c > 1) {
+			throw std::invalid_argument("gdwg::generate::rmat: invalid parameters");
+		}
+		detail::check_max_weight(max_weight);
+		auto const edges = p.edge_factor << p.scale;
+		auto const chunks = (edges + detail::chunk_size - 1) / detail::chunk_size;
+		using edge = typename graph<N, E>::value_type;
+		auto const generate_chunk = [&](auto& engine, auto chunk, auto& out) {
+			auto quadrant = std::uniform_real_distribution<double>(0.0, 1.0);
+			auto weight = detail::weight_distribution(max_weight);
+			auto const count = std::min(detail::chunk_size, edges - chunk * detail::chunk_size);
+			out.reserve(count);
+			for (auto i = std::size_t{0}; i < count; ++i) {
+				auto from = N{0};
+				auto to = N{0};
+				for (auto bit = 0U; bit < p.scale; ++bit) {
+					auto const r = quadrant(engine);
+					auto const right = (r >= p.a and r < p.a + p.b) or r >= p.a + p.b + p.c;
+					auto const down = r >= p.a + p.b;
+					from = static_cast<N>(from | (static_cast<N>(down) << bit));
+					to = static_cast<N>(to | (static_cast<N>(right) << bit));
+				}
+				out.push_back({from, to, weight(engine)});
+			}
+		};
+		return detail::run_chunks<edge>(chunks, p.seed, policy, generate_chunk);
+	}
+
+	// directed G(n, p) without self loops. Skips over the absent edges with geometric jumps
+	// (Batagelj-Brandes) ==> O(n + m) instead of O(n^2)
+	template<std::integral N, typename E>
+	requires std::is_arithmetic_v<E> //
+	   auto erdos_renyi(std::size_t n,
+	                    double p,
+	                    std::uint64_t seed,
+	                    E max_weight = E{100},
+	                    execution policy = {}) -> edge_list<N, E> {
+		if (p < 0 or p > 1) {
+			throw std::invalid_argument("gdwg::generate::erdos_renyi: p must be in [0, 1]");
+		}
+		detail::check_max_weight(max_weight);
+		using edge = typename graph<N, E>::value_type;
+		if (n < 2 or p == 0) {
+			return {};
+		}
+		// one chunk per block of sources, so that the number of chunks doesn't depend on p
+		auto const rows = std::max(std::size_t{1}, detail::chunk_size / n);
+		auto const chunks = (n + rows - 1) / rows;
+		auto const generate_chunk = [&](auto& engine, auto chunk, auto& out) {
+			auto weight = detail::weight_distribution(max_weight);
+			auto const first = chunk * rows;
+			auto const last = std::min(n, first + rows);
+			for (auto from = first; from < last; ++from) {
+				if (p == 1) {
+					for (auto to = std::size_t{0}; to < n; ++to) {
+						if (to != from) {
+							out.push_back({static_cast<N>(from), static_cast<N>(to), weight(engine)});
+						}
+					}
+					continue;
+				}
+				// the n - 1 candidate destinations of from, skipping from itself
+				auto skip = std::geometric_distribution<std::size_t>(p);
+				for (auto k = skip(engine); k < n - 1;) {
+					auto const to = k < from ? k : k + 1;
+					out.push_back({static_cast<N>(from), static_cast<N>(to), weight(engine)});
+					// the jump can be close to the maximum of std::size_t for a tiny p: compare it
+					// with the room left instead of adding it to k
+					auto const jump = skip(engine);
+					if (jump >= n - 2 - k) {
+						break;
+					}
+					k += 1 + jump;
+				}
+			}
+		};
+		return detail::run_chunks<edge>(chunks, seed, policy, generate_chunk);
+	}
+
+	// Barabasi-Albert preferential attachment: every new node links to m distinct existing nodes
+	// picked with a probability proportional to their degree, both ways. Starts from a clique of
+	// m + 1 nodes. Each step depends on all the previous ones ==> always sequential
+	template<std::integral N, typename E>
+	requires std::is_arithmetic_v<E> //
+	   auto barabasi_albert(std::size_t n, std::size_t m, std::uint64_t seed, E max_weight = E{100})
+	      -> edge_list<N, E> {
+		if (m == 0 or n <= m) {
+			throw std::invalid_argument("gdwg::generate::barabasi_albert: needs 0 < m < n");
+		}
+		detail::check_max_weight(max_weight);
+		auto engine = detail::chunk_engine(seed, 0);
+		auto weight = detail::weight_distribution(max_weight);
+		auto result = edge_list<N, E>{};
+		result.reserve(2 * (m * (m + 1) / 2 + (n - m - 1) * m));
+		// every node appears once per incident edge ==> uniform picks are degree proportional
+		auto ends = std::vector<N>{};
+		auto const link = [&](N a, N b) {
+			auto const w = weight(engine);
+			result.push_back({a, b, w});
+			result.push_back({b, a, w});
+			ends.push_back(a);
+			ends.push_back(b);
+		};
+		for (auto a = std::size_t{0}; a <= m; ++a) {
+			for (auto b = a + 1; b <= m; ++b) {
+				link(static_cast<N>(a), static_cast<N>(b));
+			}
+		}
+		auto targets = std::vector<N>{};
+		for (auto node = m + 1; node < n; ++node) {
+			targets.clear();
+			auto pick = std::uniform_int_distribution<std::size_t>(0, ends.size() - 1);
+			while (targets.size() < m) {
+				auto const target = ends[pick(engine)];
+				if (std::find(targets.begin(), targets.end(), target) == targets.end()) {
+					targets.push_back(target);
+				}
+			}
+			for (auto const target : targets) {
+				link(static_cast<N>(node), target);
+			}
+		}
+		return result;
+	}
+
+	// road like rows x cols lattice: node r * cols + c is linked both ways to its right and lower
+	// neighbours, with the same weight in the two directions
+	template<std::integral N, typename E>
+	requires std::is_arithmetic_v<E> //
+	   auto grid(std::size_t rows,
+	             std::size_t cols,
+	             std::uint64_t seed,
+	             E max_weight = E{100},
+	             execution policy = {}) -> edge_list<N, E> {
+		using edge = typename graph<N, E>::value_type;
+		detail::check_max_weight(max_weight);
+		if (rows == 0 or cols == 0) {
+			return {};
+		}
+		auto const rows_per_chunk = std::max(std::size_t{1}, detail::chunk_size / cols);
+		auto const chunks = (rows + rows_per_chunk - 1) / rows_per_chunk;
+		auto const generate_chunk = [&](auto& engine, auto chunk, auto& out) {
+			auto weight = detail::weight_distribution(max_weight);
+			auto const link = [&](std::size_t a, std::size_t b) {
+				auto const w = weight(engine);
+				out.push_back({static_cast<N>(a), static_cast<N>(b), w});
+				out.push_back({static_cast<N>(b), static_cast<N>(a), w});
+			};
+			auto const last = std::min(rows, (chunk + 1) * rows_per_chunk);
+			for (auto r = chunk * rows_per_chunk; r < last; ++r) {
+				for (auto c = std::size_t{0}; c < cols; ++c) {
+					auto const node = r * cols + c;
+					if (c + 1 < cols) {
+						link(node, node + 1);
+					}
+					if (r + 1 < rows) {
+						link(node, node + cols);
+					}
+				}
+			}
+		};
+		return detail::run_chunks<edge>(chunks, seed, policy, generate_chunk);
+	}
+} // namespace gdwg::generate
+
+#endif // GDWG_GENERATE_HPP
@@ -1,10 +1,17 @@
 #ifndef GDWG_GRAPH_HPP
 #define GDWG_GRAPH_HPP
 
+#include <algorithm>
 #include <concepts/concepts.hpp>
+#include <cstddef>
 #include <fmt/format.h>
+#include <gdwg/detail/bloom_filter.hpp>
+#include <gdwg/detail/lru_cache.hpp>
 #include <initializer_list>
+#include <iterator>
+#include <map>
 #include <memory>
+#include <optional>
 #include <ostream>
 #include <range/v3/algorithm.hpp>
 #include <range/v3/algorithm/equal.hpp>
@@ -14,8 +21,41 @@
 #include <range/v3/utility.hpp>
 #include <range/v3/view.hpp>
 #include <set>
+#include <stdexcept>
+#include <string_view>
 #include <type_traits>
 #include <typeinfo>
+#include <utility>
+#include <vector>
+
+// opt-in latency histograms of the public members, see gdwg/latency.hpp
+#ifdef GDWG_ENABLE_LATENCY
+#include <gdwg/latency.hpp>
+#define GDWG_LATENCY_SCOPE(op)                                                                     \
+	::gdwg::latency::probe const gdwg_latency_probe_(::gdwg::latency::operation::op)
+#else
+#define GDWG_LATENCY_SCOPE(op) static_cast<void>(0)
+#endif
+
+// opt-in spans of the public members and of their phases, see gdwg/trace.hpp
+#ifdef GDWG_ENABLE_TRACE
+#include <gdwg/trace.hpp>
+#define GDWG_TRACE_CONCAT_IMPL(a, b) a##b
+#define GDWG_TRACE_CONCAT(a, b) GDWG_TRACE_CONCAT_IMPL(a, b)
+#define GDWG_TRACE_SCOPE(name)                                                                     \
+	::gdwg::trace::span const GDWG_TRACE_CONCAT(gdwg_trace_span_, __LINE__)(name)
+#define GDWG_TRACE_PHASES(name) ::gdwg::trace::phase gdwg_trace_phase_(name)
+#define GDWG_TRACE_NEXT_PHASE(name) gdwg_trace_phase_.next(name)
+#else
+#define GDWG_TRACE_SCOPE(name) static_cast<void>(0)
+#define GDWG_TRACE_PHASES(name) static_cast<void>(0)
+#define GDWG_TRACE_NEXT_PHASE(name) static_cast<void>(0)
+#endif
+
+// first statement of every public member: both compile to nothing unless enabled
+#define GDWG_OPERATION(op)                                                                         \
+	GDWG_LATENCY_SCOPE(op);                                                                        \
+	GDWG_TRACE_SCOPE("graph::" #op)
 
 namespace gdwg {
 	template<concepts::regular N, concepts::regular E>
@@ -61,6 +101,15 @@ namespace gdwg {
 		graph(graph&& other) noexcept {
 			nodes_ = std::move(other.nodes_);
 			all_edges_ = std::move(other.all_edges_);
+			min_weight_ = std::move(other.min_weight_);
+			max_weight_ = std::move(other.max_weight_);
+			edge_filter_ = std::move(other.edge_filter_);
+			edge_filter_stale_ = std::exchange(other.edge_filter_stale_, 0);
+			connections_cache_ = std::move(other.connections_cache_);
+			weights_cache_ = std::move(other.weights_cache_);
+			// iterators into a moved std::set stay valid ==> so does the index
+			out_edges_by_weight_ = std::exchange(other.out_edges_by_weight_, std::nullopt);
+			edges_by_weight_ = std::exchange(other.edges_by_weight_, std::nullopt);
 		}
 
 		auto operator=(graph&& other) noexcept -> graph& {
@@ -69,10 +118,24 @@ namespace gdwg {
 			}
 			nodes_ = std::move(other.nodes_);
 			all_edges_ = std::move(other.all_edges_);
+			min_weight_ = std::move(other.min_weight_);
+			max_weight_ = std::move(other.max_weight_);
+			edge_filter_ = std::move(other.edge_filter_);
+			edge_filter_stale_ = std::exchange(other.edge_filter_stale_, 0);
+			connections_cache_ = std::move(other.connections_cache_);
+			weights_cache_ = std::move(other.weights_cache_);
+			// iterators into a moved std::set stay valid ==> so does the index
+			out_edges_by_weight_ = std::exchange(other.out_edges_by_weight_, std::nullopt);
+			edges_by_weight_ = std::exchange(other.edges_by_weight_, std::nullopt);
 			return *this;
 		}
 
-		graph(graph const& other) {
+		graph(graph const& other)
+		: connections_cache_(other.connections_cache_.capacity())
+		, weights_cache_(other.weights_cache_.capacity()) {
+			if (not other.edge_filter_.empty()) {
+				enable_edge_filter(other.all_edges_.size());
+			}
 			for (auto const& ptr_node : other.nodes_) {
 				auto const& node = *ptr_node;
 				insert_node(node);
@@ -90,6 +153,13 @@ namespace gdwg {
 				return *this;
 			}
 			clear();
+			if (other.edge_filter_.empty()) {
+				disable_edge_filter();
+			}
+			else {
+				enable_edge_filter(other.all_edges_.size());
+			}
+			enable_query_cache(other.connections_cache_.capacity());
 			for (auto const ptr_node : other.nodes_) {
 				auto const& node = *ptr_node;
 				insert_node(node);
@@ -105,6 +175,7 @@ namespace gdwg {
 
 		//---------------------------- modifiers -----------------------------------------
 		auto insert_node(N const& value) -> bool {
+			GDWG_OPERATION(insert_node);
 			if (is_node(value)) {
 				return false;
 			}
@@ -112,50 +183,116 @@ namespace gdwg {
 			return true;
 		}
 
-		auto insert_edge(N const& src, N const& dst, E const& weight) -> bool {
-			if (not is_node(src) or not is_node(dst)) {
-				throw std::runtime_error("Cannot call gdwg::graph<N, E>::insert_edge when either src "
-				                         "or dst node does not exist");
-			}
-			// initialize min_weight and max_weight for first edge, in case that <E> may not have a
-			// default constructor
-			if (all_edges_.empty()) {
-				min_weight_ = weight;
-				max_weight_ = weight;
-			}
-			// get the smart pointers of src and dst which are stored in the set
-			auto& src_ptr = *nodes_.find(std::make_shared<N>(src));
-			auto& dst_ptr = *nodes_.find(std::make_shared<N>(dst));
-			auto weight_ptr = std::make_shared<E>(weight);
-			auto new_edge = edge_type{src_ptr, dst_ptr, weight_ptr};
-
-			// new_edge already exist ==> should return false
-			if (all_edges_.count(new_edge)) {
+		// value is moved into the graph, and only if it isn't a node yet
+		auto insert_node(N&& value) -> bool {
+			GDWG_OPERATION(insert_node);
+			if (is_node(value)) {
 				return false;
 			}
-
-			all_edges_.emplace(new_edge);
-			// private helper function: update min_weight_ and max_weight
-			update_weight_limits(weight);
+			nodes_.emplace(std::make_shared<N>(std::move(value)));
 			return true;
 		}
 
+		// construct the node in place, exactly once. It is discarded if it already exists
+		template<typename... Args>
+		requires std::constructible_from<N, Args...> auto emplace_node(Args&&... args) -> bool {
+			GDWG_OPERATION(emplace_node);
+			return nodes_.emplace(std::make_shared<N>(std::forward<Args>(args)...)).second;
+		}
+
+		auto insert_edge(N const& src, N const& dst, E const& weight) -> bool {
+			GDWG_OPERATION(insert_edge);
+			return emplace_edge_ptr(src, dst, make_weight(weight), "insert_edge").second;
+		}
+
+		auto insert_edge(N const& src, N const& dst, E&& weight) -> bool {
+			GDWG_OPERATION(insert_edge);
+			return emplace_edge_ptr(src, dst, make_weight(std::move(weight)), "insert_edge").second;
+		}
+
+		// construct the weight in place, exactly once
+		template<typename... Args>
+		requires std::constructible_from<E, Args...> auto
+		emplace_edge(N const& src, N const& dst, Args&&... args) -> bool {
+			GDWG_OPERATION(emplace_edge);
+			return emplace_edge_ptr(src, dst, make_weight(std::forward<Args>(args)...), "emplace_edge")
+			   .second;
+		}
+
+		// like insert_edge, but also returns an iterator to the edge, whether it was inserted (true)
+		// or already there (false). A single search of all_edges_
+		auto try_insert_edge(N const& src, N const& dst, E weight) -> std::pair<iterator, bool> {
+			GDWG_OPERATION(try_insert_edge);
+			auto const [it, inserted] =
+			   emplace_edge_ptr(src, dst, make_weight(std::move(weight)), "try_insert_edge");
+			return {iterator(it), inserted};
+		}
+
+		// insert every edge of values, best sorted like the iteration order: each edge is inserted
+		// with the position after the previous one as hint ==> amortized O(1) instead of O(log(e))
+		// when it lands right there, and the caches are invalidated once per source. Throws before
+		// the graph is modified if an end isn't a node. Returns the number of inserted edges
+		template<ranges::forward_range R>
+		requires std::convertible_to<ranges::range_reference_t<R const>, value_type const&> auto
+		insert_edges(R const& values) -> std::size_t {
+			GDWG_OPERATION(insert_edges);
+			auto const ends =
+			   node_ptrs_of(values, "insert_edges when either src or dst node does not exist");
+			auto hint = all_edges_.begin();
+			auto invalidated = std::shared_ptr<N>{};
+			auto inserted = std::size_t{0};
+			auto i = std::size_t{0};
+			for (value_type const& value : values) {
+				auto const& [ptr_src, ptr_dst] = ends[i++];
+				if (all_edges_.empty()) {
+					min_weight_ = value.weight;
+					max_weight_ = value.weight;
+				}
+				auto const size_before = all_edges_.size();
+				auto edge = edge_type{ptr_src, ptr_dst, make_weight(value.weight)};
+				auto const it = all_edges_.emplace_hint(hint, std::move(edge));
+				hint = std::next(it);
+				if (all_edges_.size() == size_before) {
+					continue;
+				}
+				++inserted;
+				filter_insert(*it);
+				index_insert(it);
+				update_weight_limits(*it->weight);
+				if (ptr_src != invalidated) {
+					invalidate_source(*ptr_src);
+					invalidated = ptr_src;
+				}
+			}
+			return inserted;
+		}
+
 		// insert new_data to nodes and then merge_replace_node(old_data, new_date)
 		auto replace_node(N const& old_data, N const& new_data) -> bool {
-			if (not is_node(old_data)) {
-				throw std::runtime_error("Cannot call gdwg::graph<N, E>::replace_node on a node that "
-				                         "doesn't exist");
-			}
-			if (is_node(new_data)) {
+			GDWG_OPERATION(replace_node);
+			if (not can_replace_node(old_data, new_data)) {
 				return false;
 			}
 			auto ptr_new_node = std::make_shared<N>(new_data);
 			nodes_.emplace(ptr_new_node);
-			merge_replace_node(old_data, new_data);
+			merge_replace_node(old_data, *ptr_new_node);
+			return true;
+		}
+
+		auto replace_node(N const& old_data, N&& new_data) -> bool {
+			GDWG_OPERATION(replace_node);
+			if (not can_replace_node(old_data, new_data)) {
+				return false;
+			}
+			auto ptr_new_node = std::make_shared<N>(std::move(new_data));
+			nodes_.emplace(ptr_new_node);
+			merge_replace_node(old_data, *ptr_new_node);
 			return true;
 		}
 
 		auto merge_replace_node(N const& old_data, N const& new_data) -> void {
+			GDWG_OPERATION(merge_replace_node);
+			GDWG_TRACE_PHASES("lookup");
 			if (not is_node(old_data) or not is_node(new_data)) {
 				throw std::runtime_error("Cannot call gdwg::graph<N, E>::merge_replace_node on old or "
 				                         "new data if they don't exist in the graph");
@@ -163,9 +300,10 @@ namespace gdwg {
 			if (old_data == new_data) {
 				return;
 			}
-			auto ptr_old_node = *nodes_.find(std::make_shared<N>(old_data));
-			auto ptr_new_node = *nodes_.find(std::make_shared<N>(new_data));
+			auto ptr_old_node = *nodes_.find(old_data);
+			auto ptr_new_node = *nodes_.find(new_data);
 			nodes_.erase(ptr_old_node);
+			GDWG_TRACE_NEXT_PHASE("scan");
 
 			// the code blow looks urgly, but I have no idea how to relace with range loop or
 			// functions: Sometimes it = all_edges.erase(it) and sometimes ++it ==> to maintian O(N)
@@ -178,80 +316,379 @@ namespace gdwg {
 					edge.dst = ptr_new_node;
 				}
 			};
+			auto stale = std::size_t{0};
 			for (auto it = all_edges_.begin(); it != all_edges_.end();) {
 				auto edge = *it;
 				if (*edge.src == old_data or *edge.dst == old_data) {
 					// I don't know how to replace range function because of this line
 					// below: it = all_edges_.erase(it);
-					it = all_edges_.erase(it);
+					GDWG_TRACE_SCOPE("rebalance");
+					invalidate_source(*edge.src);
+					it = erase_at(it);
 					update_edge(edge);
-					all_edges_.emplace(edge);
+					if (auto const result = all_edges_.emplace(edge); result.second) {
+						index_insert(result.first);
+					}
+					filter_insert(edge);
+					++stale;
 					continue;
 				}
 				++it;
 			}
+			filter_note_erased(stale);
+			invalidate_source(old_data);
+			invalidate_source(new_data);
 		}
 
 		auto erase_node(N const& value) -> bool {
+			GDWG_OPERATION(erase_node);
+			GDWG_TRACE_PHASES("lookup");
 			if (not is_node(value)) {
 				return false;
 			}
-			auto ptr_to_remove = *nodes_.find(std::make_shared<N>(value));
+			auto ptr_to_remove = *nodes_.find(value);
 			nodes_.erase(ptr_to_remove);
+			invalidate_source(value);
+			GDWG_TRACE_NEXT_PHASE("scan");
 
+			auto erased = std::size_t{0};
 			for (auto it = all_edges_.begin(); it != all_edges_.end();) {
 				auto const& edge = *it;
 				if (*edge.src == value or *edge.dst == value) {
-					it = all_edges_.erase(it);
+					invalidate_source(*edge.src);
+					it = erase_at(it);
+					++erased;
 					continue;
 				}
 				++it;
 			}
+			filter_note_erased(erased);
 			return true;
 		}
 
+		// erase every node of [first, last) and their edges with a single pass over all_edges_:
+		// O(e log(k) + k log(n)) instead of O(k e) for k calls to erase_node.
+		// Values that aren't nodes are ignored. Return the number of erased nodes
+		template<ranges::forward_iterator I, ranges::sentinel_for<I> S>
+		auto erase_nodes(I first, S last) -> std::size_t {
+			GDWG_OPERATION(erase_nodes);
+			GDWG_TRACE_PHASES("lookup");
+			// edges point to the stored nodes ==> compare addresses instead of values
+			auto to_erase = std::vector<std::shared_ptr<N>>{};
+			ranges::for_each(first, last, [this, &to_erase](N const& value) {
+				if (auto const it = nodes_.find(value); it != nodes_.end()) {
+					to_erase.push_back(*it);
+				}
+			});
+			ranges::sort(to_erase);
+			to_erase.erase(std::unique(to_erase.begin(), to_erase.end()), to_erase.end());
+			if (to_erase.empty()) {
+				return 0;
+			}
+			auto const is_erased = [&to_erase](std::shared_ptr<N> const& ptr) {
+				return std::binary_search(to_erase.begin(), to_erase.end(), ptr);
+			};
+			GDWG_TRACE_NEXT_PHASE("scan");
+
+			auto erased = std::size_t{0};
+			for (auto it = all_edges_.begin(); it != all_edges_.end();) {
+				if (is_erased(it->src) or is_erased(it->dst)) {
+					invalidate_source(*it->src);
+					it = erase_at(it);
+					++erased;
+					continue;
+				}
+				++it;
+			}
+			filter_note_erased(erased);
+			for (auto const& ptr : to_erase) {
+				invalidate_source(*ptr);
+				nodes_.erase(ptr);
+			}
+			return to_erase.size();
+		}
+
+		template<ranges::forward_range R>
+		auto erase_nodes(R const& values) -> std::size_t {
+			return erase_nodes(ranges::begin(values), ranges::end(values));
+		}
+
+		// merge_replace_node(old, new) for every (old, new) pair of mapping, with a single pass over
+		// all_edges_. Edges that become equal are merged, exactly like merge_replace_node.
+		// Every old and new node must exist, and a new node can't be replaced itself in the same
+		// call: otherwise throw before the graph is modified
+		template<ranges::forward_range R>
+		auto merge_replace_nodes(R const& mapping) -> void {
+			GDWG_OPERATION(merge_replace_nodes);
+			GDWG_TRACE_PHASES("lookup");
+			auto replacement = std::map<std::shared_ptr<N>, std::shared_ptr<N>>{};
+			auto targets = std::set<std::shared_ptr<N>>{};
+			for (auto const& [old_data, new_data] : mapping) {
+				auto const it_old = nodes_.find(old_data);
+				auto const it_new = nodes_.find(new_data);
+				if (it_old == nodes_.end() or it_new == nodes_.end()) {
+					throw std::runtime_error("Cannot call gdwg::graph<N, E>::merge_replace_nodes on old "
+					                         "or new data if they don't exist in the graph");
+				}
+				if (*it_old == *it_new) {
+					continue;
+				}
+				auto const [it, inserted] = replacement.emplace(*it_old, *it_new);
+				if (not inserted and it->second != *it_new) {
+					throw std::runtime_error("Cannot call gdwg::graph<N, E>::merge_replace_nodes when "
+					                         "a node is replaced by more than one node");
+				}
+				targets.insert(*it_new);
+			}
+			for (auto const& [old_ptr, new_ptr] : replacement) {
+				if (targets.count(old_ptr)) {
+					throw std::runtime_error("Cannot call gdwg::graph<N, E>::merge_replace_nodes when "
+					                         "a new node is also replaced");
+				}
+			}
+			if (replacement.empty()) {
+				return;
+			}
+			auto const replaced = [&replacement](std::shared_ptr<N> const& ptr) {
+				auto const it = replacement.find(ptr);
+				return it == replacement.end() ? ptr : it->second;
+			};
+
+			// take the touched edges out of the set (no reallocation), rewrite them, then put them
+			// back: re-inserting during the scan would visit them again
+			GDWG_TRACE_NEXT_PHASE("scan");
+			auto rewritten = std::vector<typename std::set<edge_type>::node_type>{};
+			for (auto it = all_edges_.begin(); it != all_edges_.end();) {
+				if (replacement.count(it->src) or replacement.count(it->dst)) {
+					invalidate_source(*it->src);
+					index_erase(it);
+					auto handle = all_edges_.extract(it++);
+					handle.value().src = replaced(handle.value().src);
+					handle.value().dst = replaced(handle.value().dst);
+					rewritten.push_back(std::move(handle));
+					continue;
+				}
+				++it;
+			}
+			GDWG_TRACE_NEXT_PHASE("rebalance");
+			for (auto& handle : rewritten) {
+				auto const result = all_edges_.insert(std::move(handle));
+				if (result.inserted) {
+					filter_insert(*result.position);
+					index_insert(result.position);
+				}
+			}
+			filter_note_erased(rewritten.size());
+			for (auto const& [old_ptr, new_ptr] : replacement) {
+				invalidate_source(*old_ptr);
+				invalidate_source(*new_ptr);
+				nodes_.erase(old_ptr);
+			}
+		}
+
 		// remove edge from set<edge_type> all_edges_ ==> O(log(e))
 		auto erase_edge(N const& src, N const& dst, E const& weight) -> bool {
+			GDWG_OPERATION(erase_edge);
 			if (not is_node(src) or not is_node(dst)) {
 				throw std::runtime_error("Cannot call gdwg::graph<N, E>::erase_edge on src or dst if "
 				                         "they don't exist in the graph");
 			}
-			auto ptr_src = std::make_shared<N>(src);
-			auto ptr_dst = std::make_shared<N>(dst);
+			auto ptr_src = *nodes_.find(src);
+			auto ptr_dst = *nodes_.find(dst);
 			auto edge = edge_type{ptr_src, ptr_dst, std::make_shared<E>(weight)};
 
-			if (not all_edges_.count(edge)) { // O(log(e))
+			auto const it = all_edges_.find(edge); // O(log(e))
+			if (it == all_edges_.end()) {
 				return false;
 			}
-			all_edges_.erase(edge); // O(log(e))
+			erase_at(it); // amortized O(1)
+			filter_note_erased(1);
+			invalidate_source(src);
 			return true;
 		}
 
 		// erase from set<edge_type> all_edges_ using known iterator ==> amortized O(1)
 		auto erase_edge(iterator i) -> iterator {
+			GDWG_OPERATION(erase_edge);
 			auto edge_iter = get_inner(i); // read from iterator ==> O(1)
-			auto edge_iter_returned = all_edges_.erase(edge_iter);
+			invalidate_source(*edge_iter->src);
+			auto edge_iter_returned = erase_at(edge_iter);
+			filter_note_erased(1);
 			return iterator(edge_iter_returned);
 		}
 
 		// erase from set<edge_type> all_edges_ using knwon iterator range: O(d)
 		auto erase_edge(iterator i, iterator s) -> iterator {
+			GDWG_OPERATION(erase_edge);
 			auto edge_iter_begin = get_inner(i); // read from iterator ==> O(1)
 			auto edge_iter_end = get_inner(s); // read from iterator ==> O(1)
+			auto erased = std::size_t{0};
+			for (auto it = edge_iter_begin; it != edge_iter_end; ++it, ++erased) {
+				invalidate_source(*it->src);
+				index_erase(it);
+			}
 			auto edge_iter_returned = all_edges_.erase(edge_iter_begin, edge_iter_end);
+			filter_note_erased(erased);
 			return iterator(edge_iter_returned);
 		}
 
+		// erase every edge of values, best sorted like the iteration order: each edge is first looked
+		// for right after the previous one, in O(1), before a search of all_edges_, and the caches
+		// are invalidated once per source. Edges that don't exist are ignored. Throws before the
+		// graph is modified if an end isn't a node. Returns the number of erased edges
+		template<ranges::forward_range R>
+		requires std::convertible_to<ranges::range_reference_t<R const>, value_type const&> auto
+		erase_edges(R const& values) -> std::size_t {
+			GDWG_OPERATION(erase_edges);
+			auto const ends =
+			   node_ptrs_of(values, "erase_edges on src or dst if they don't exist in the graph");
+			// a single weight for every search key, overwritten each time
+			auto key = edge_type{nullptr, nullptr, nullptr};
+			auto next = all_edges_.begin();
+			auto invalidated = std::shared_ptr<N>{};
+			auto erased = std::size_t{0};
+			auto i = std::size_t{0};
+			for (value_type const& value : values) {
+				auto const& [ptr_src, ptr_dst] = ends[i++];
+				if (key.weight) {
+					*key.weight = value.weight;
+				}
+				else {
+					key.weight = std::make_shared<E>(value.weight);
+				}
+				key.src = ptr_src;
+				key.dst = ptr_dst;
+				auto const it = next != all_edges_.end() and *next == key ? next : all_edges_.find(key);
+				if (it == all_edges_.end()) {
+					continue;
+				}
+				next = erase_at(it);
+				++erased;
+				if (ptr_src != invalidated) {
+					invalidate_source(*ptr_src);
+					invalidated = ptr_src;
+				}
+			}
+			filter_note_erased(erased);
+			return erased;
+		}
+
+		// erase every edge whose weight is below threshold, found through the weight index
+		// ==> O(log(e) + k) for k erased edges. Returns k
+		auto erase_edges_with_weight_below(E const& threshold) -> std::size_t {
+			GDWG_OPERATION(erase_edges_with_weight_below);
+			auto& index = weight_index();
+			auto const last = index.lower_bound(threshold);
+			auto erased = std::size_t{0};
+			for (auto it = index.begin(); it != last; ++erased) {
+				auto const edge_iter = *it;
+				it = index.erase(it);
+				invalidate_source(*edge_iter->src);
+				all_edges_.erase(edge_iter);
+				if (out_edges_by_weight_) {
+					out_edges_by_weight_->erase(edge_iter);
+				}
+			}
+			filter_note_erased(erased);
+			return erased;
+		}
+
+		// change the weight of the edge i points to, in place: the set node is extracted, its weight
+		// overwritten and the node re-inserted with its old neighbour as hint ==> no allocation, and
+		// amortized O(1) when the new weight keeps the edge at the same position of its (src, dst)
+		// group. If {src, dst, new_weight} already exists, the edge i points to is merged into it.
+		// Returns an iterator to the edge holding new_weight
+		auto update_weight(iterator i, E const& new_weight) -> iterator {
+			GDWG_OPERATION(update_weight);
+			auto edge_iter = get_inner(i); // read from iterator ==> O(1)
+			if (*edge_iter->weight == new_weight) {
+				return i;
+			}
+			invalidate_source(*edge_iter->src);
+			auto hint = std::next(edge_iter);
+			index_erase(edge_iter);
+			auto handle = all_edges_.extract(edge_iter);
+			// every edge owns its weight ==> overwrite it instead of allocating a new one
+			*handle.value().weight = new_weight;
+			update_weight_limits(new_weight);
+			auto const size_before = all_edges_.size();
+			auto const result = all_edges_.insert(hint, std::move(handle));
+			if (all_edges_.size() != size_before) {
+				index_insert(result);
+			}
+			return iterator(result);
+		}
+
+		// same as update_weight(find(src, dst, old_weight), new_weight)
+		// return false if there is no edge {src, dst, old_weight}
+		auto update_weight(N const& src, N const& dst, E const& old_weight, E const& new_weight)
+		   -> bool {
+			GDWG_OPERATION(update_weight);
+			if (not is_node(src) or not is_node(dst)) {
+				throw std::runtime_error("Cannot call gdwg::graph<N, E>::update_weight on src or dst "
+				                         "if they don't exist in the graph");
+			}
+			auto it = find(src, dst, old_weight);
+			if (it == end()) {
+				return false;
+			}
+			update_weight(it, new_weight);
+			return true;
+		}
+
 		// clear all nodes and edges
 		auto clear() noexcept -> void {
 			nodes_.clear();
 			all_edges_.clear();
+			edge_filter_.clear();
+			edge_filter_stale_ = 0;
+			connections_cache_.clear();
+			weights_cache_.clear();
+			out_edges_by_weight_.reset();
+			edges_by_weight_.reset();
+		}
+
+		//---------------------------- edge filter -----------------------------------------
+		// opt-in bloom filter over (src, dst) pairs: is_connected() and find() answer most negative
+		// queries from a single cache line without descending all_edges_.
+		// The filter never gives false negatives. Erased edges leave stale bits behind, so the
+		// filter is rebuilt once the number of erased edges gets close to its capacity
+		auto enable_edge_filter(std::size_t expected_edges = 0) -> void {
+			filter_rebuild(std::max(expected_edges, all_edges_.size()));
+		}
+
+		auto disable_edge_filter() noexcept -> void {
+			edge_filter_ = detail::blocked_bloom_filter{};
+			edge_filter_stale_ = 0;
+		}
+
+		[[nodiscard]] auto edge_filter_enabled() const noexcept -> bool {
+			return not edge_filter_.empty();
+		}
+
+		//---------------------------- query cache -----------------------------------------
+		// opt-in LRU caches in front of connections(src) and weights(src, dst), holding up to
+		// `capacity` results each. Every modifier drops the cached results of the sources it touches.
+		// Note: with the cache enabled the const accessors update the cache, so they must not be
+		// called concurrently
+		auto enable_query_cache(std::size_t capacity) -> void {
+			connections_cache_ = detail::lru_cache<N, std::vector<N>>(capacity);
+			weights_cache_ = weights_cache_type(capacity);
+		}
+
+		auto disable_query_cache() noexcept -> void {
+			enable_query_cache(0);
+		}
+
+		[[nodiscard]] auto query_cache_enabled() const noexcept -> bool {
+			return connections_cache_.capacity() != 0;
 		}
 
 		//-------------------------------- Accessors --------------------------------------------
+		// compare_ptr_by_content is transparent ==> no need to allocate a shared_ptr to look up
 		[[nodiscard]] auto is_node(N const& value) const -> bool {
-			auto ptr_to_varify = std::make_shared<N>(value);
-			return nodes_.count(ptr_to_varify);
+			GDWG_OPERATION(is_node);
+			return nodes_.find(value) != nodes_.end();
 		}
 
 		[[nodiscard]] auto empty() const -> bool {
@@ -264,12 +701,18 @@ namespace gdwg {
 		// if so and the found edge is within the range of [min_edge, max_edge],
 		// then src and dst are connected
 		[[nodiscard]] auto is_connected(N const& src, N const& dst) const -> bool {
-			if (not is_node(src) or not is_node(dst)) {
+			GDWG_OPERATION(is_connected);
+			auto const it_src = nodes_.find(src);
+			auto const it_dst = nodes_.find(dst);
+			if (it_src == nodes_.end() or it_dst == nodes_.end()) {
 				throw std::runtime_error("Cannot call gdwg::graph<N, E>::is_connected if src or dst "
 				                         "node don't exist in the graph");
 			}
-			auto ptr_src = std::make_shared<N>(src);
-			auto ptr_dst = std::make_shared<N>(dst);
+			if (not filter_may_contain(*it_src, *it_dst)) {
+				return false;
+			}
+			auto const& ptr_src = *it_src;
+			auto const& ptr_dst = *it_dst;
 			auto min_edge = edge_type{ptr_src, ptr_dst, std::make_shared<E>(min_weight_)};
 			auto max_edge = edge_type{ptr_src, ptr_dst, std::make_shared<E>(max_weight_)};
 			auto iter = all_edges_.lower_bound(min_edge);
@@ -278,6 +721,7 @@ namespace gdwg {
 
 		// inorder travelsal of set<ptr_N> ==> O(N) time complexity
 		[[nodiscard]] auto nodes() const -> std::vector<N> {
+			GDWG_OPERATION(nodes);
 			auto result = std::vector<N>{};
 			ranges::transform(nodes_, ranges::back_inserter(result), [](auto const& ptr_node) {
 				return *ptr_node;
@@ -288,12 +732,18 @@ namespace gdwg {
 		// use lower_bound() and upper_bound() to find the begin iterator and end iterator of edges
 		// from src to dst
 		[[nodiscard]] auto weights(N const& src, N const& dst) const -> std::vector<E> {
+			GDWG_OPERATION(weights);
 			if (not is_node(src) or not is_node(dst)) {
 				throw std::runtime_error("Cannot call gdwg::graph<N, E>::weights if src or dst node "
 				                         "don't exist in the graph");
 			}
-			auto ptr_src = std::make_shared<N>(src);
-			auto ptr_dst = std::make_shared<N>(dst);
+			if (query_cache_enabled()) {
+				if (auto const* cached = weights_cache_.get({src, dst})) {
+					return *cached;
+				}
+			}
+			auto ptr_src = *nodes_.find(src);
+			auto ptr_dst = *nodes_.find(dst);
 			auto edge_from = edge_type{ptr_src, ptr_dst, std::make_shared<E>(min_weight_)};
 			auto edge_to = edge_type{ptr_src, ptr_dst, std::make_shared<E>(max_weight_)};
 
@@ -308,26 +758,38 @@ namespace gdwg {
 			                  ranges::back_inserter(result),
 			                  [](edge_type const& edge) { return *edge.weight; });
 
+			if (query_cache_enabled()) {
+				weights_cache_.put({src, dst}, result);
+			}
 			return result;
 		}
 
 		[[nodiscard]] auto find(N const& src, N const& dst, E const& weight) const -> iterator {
-			auto edge = edge_type{std::make_shared<N>(src),
-			                      std::make_shared<N>(dst),
-			                      std::make_shared<E>(weight)};
+			GDWG_OPERATION(find);
+			auto const it_src = nodes_.find(src);
+			auto const it_dst = nodes_.find(dst);
+			if (it_src == nodes_.end() or it_dst == nodes_.end()
+			    or not filter_may_contain(*it_src, *it_dst)) {
+				return end();
+			}
+			auto edge = edge_type{*it_src, *it_dst, std::make_shared<E>(weight)};
 			auto it_edge = all_edges_.find(edge);
 			return iterator(it_edge);
 		}
 
 		[[nodiscard]] auto connections(N const& src) const -> std::vector<N> {
+			GDWG_OPERATION(connections);
 			if (not is_node(src)) {
 				throw std::runtime_error("Cannot call gdwg::graph<N, E>::connections if src doesn't "
 				                         "exist in the graph");
 			}
+			if (auto const* cached = connections_cache_.get(src)) {
+				return *cached;
+			}
 			// can encapsulate the blow codes in finding the iter_from iter_to? no time to implement
 			auto min_node = *nodes_.begin();
 			auto max_node = *nodes_.rbegin();
-			auto ptr_src = *nodes_.find(std::make_shared<N>(src));
+			auto ptr_src = *nodes_.find(src);
 
 			auto edge_from = edge_type{ptr_src, min_node, std::make_shared<E>(min_weight_)};
 			auto edge_to = edge_type{ptr_src, max_node, std::make_shared<E>(max_weight_)};
@@ -340,7 +802,104 @@ namespace gdwg {
 			ranges::for_each(iter_from, iter_to, [&result](edge_type const& edge) {
 				result.emplace(*edge.dst);
 			});
-			return result | ranges::to<std::vector>;
+			auto connected = result | ranges::to<std::vector>;
+			if (query_cache_enabled()) {
+				connections_cache_.put(src, connected);
+			}
+			return connected;
+		}
+
+		// the k lightest edges going out of src, lightest first, without looking at the other
+		// edges of src: answered from an index of the edges ordered by (src, weight, dst), which is
+		// built on first use and then maintained by every modifier ==> O(log(e) + k)
+		[[nodiscard]] auto k_lightest_out_edges(N const& src, std::size_t k) const
+		   -> std::vector<iterator> {
+			GDWG_OPERATION(k_lightest_out_edges);
+			auto const [first, last] = out_edges_of(src, "k_lightest_out_edges");
+			auto result = std::vector<iterator>{};
+			for (auto it = first; it != last and result.size() < k; ++it) {
+				result.emplace_back(*it);
+			}
+			return result;
+		}
+
+		// every edge with lo <= weight <= hi, lightest first, from an index of the edges ordered by
+		// (weight, src, dst) built on first use ==> O(log(e) + k) instead of a scan of all edges
+		[[nodiscard]] auto edges_with_weight_in(E const& lo, E const& hi) const
+		   -> std::vector<iterator> {
+			GDWG_OPERATION(edges_with_weight_in);
+			auto result = std::vector<iterator>{};
+			if (hi < lo) {
+				return result;
+			}
+			auto const& index = weight_index();
+			auto const last = index.upper_bound(hi);
+			for (auto it = index.lower_bound(lo); it != last; ++it) {
+				result.emplace_back(*it);
+			}
+			return result;
+		}
+
+		[[nodiscard]] auto count_edges_with_weight_in(E const& lo, E const& hi) const
+		   -> std::size_t {
+			GDWG_OPERATION(count_edges_with_weight_in);
+			if (hi < lo) {
+				return 0;
+			}
+			auto const& index = weight_index();
+			return static_cast<std::size_t>(
+			   std::distance(index.lower_bound(lo), index.upper_bound(hi)));
+		}
+
+		// the k heaviest edges going out of src, heaviest first ==> O(log(e) + k)
+		[[nodiscard]] auto k_heaviest_out_edges(N const& src, std::size_t k) const
+		   -> std::vector<iterator> {
+			GDWG_OPERATION(k_heaviest_out_edges);
+			auto const [first, last] = out_edges_of(src, "k_heaviest_out_edges");
+			auto result = std::vector<iterator>{};
+			for (auto it = last; it != first and result.size() < k;) {
+				result.emplace_back(*--it);
+			}
+			return result;
+		}
+
+		// whether dst can be reached from src using only edges of weight <= max_weight. Every node
+		// reaches itself. The edges of a (src, dst) pair are sorted by weight ==> only the lightest
+		// one is looked at and the rest of the group is skipped with one upper_bound
+		[[nodiscard]] auto
+		reachable_with_max_weight(N const& src, N const& dst, E const& max_weight) const -> bool {
+			GDWG_OPERATION(reachable_with_max_weight);
+			auto const it_src = nodes_.find(src);
+			auto const it_dst = nodes_.find(dst);
+			if (it_src == nodes_.end() or it_dst == nodes_.end()) {
+				throw std::runtime_error("Cannot call gdwg::graph<N, E>::reachable_with_max_weight if "
+				                         "src or dst node don't exist in the graph");
+			}
+			auto found = false;
+			search_with_max_weight(*it_src, max_weight, [&](std::shared_ptr<N> const& node) {
+				found = node == *it_dst;
+				return not found;
+			});
+			return found;
+		}
+
+		// every node reachable from src, src included, using only edges of weight <= max_weight.
+		// In ascending order
+		[[nodiscard]] auto reachable_with_max_weight(N const& src, E const& max_weight) const
+		   -> std::vector<N> {
+			GDWG_OPERATION(reachable_with_max_weight);
+			auto const it_src = nodes_.find(src);
+			if (it_src == nodes_.end()) {
+				throw std::runtime_error("Cannot call gdwg::graph<N, E>::reachable_with_max_weight if "
+				                         "src doesn't exist in the graph");
+			}
+			auto result = std::vector<N>{};
+			search_with_max_weight(*it_src, max_weight, [&](std::shared_ptr<N> const& node) {
+				result.push_back(*node);
+				return true;
+			});
+			std::sort(result.begin(), result.end());
+			return result;
 		}
 
 		//--------------------------------- range access ------------------------------------
@@ -356,6 +915,7 @@ namespace gdwg {
 
 		// check address equal, then check number of nodes and edges, then check values
 		[[nodiscard]] auto operator==(graph const& other) const -> bool {
+			GDWG_OPERATION(equal);
 			if (this == &other) {
 				return true;
 			}
@@ -376,6 +936,7 @@ namespace gdwg {
 		}
 		// ------------------------------ extractor ----------------------------------------
 		friend auto operator<<(std::ostream& os, graph const& g) -> std::ostream& {
+			GDWG_OPERATION(print);
 			if (g.empty()) {
 				return os;
 			}
@@ -459,10 +1020,19 @@ namespace gdwg {
 	private:
 		template<concepts::regular T>
 		requires concepts::totally_ordered<T> struct compare_ptr_by_content {
+			// allow nodes_.find(value) without wrapping value into a shared_ptr
+			using is_transparent = void;
+
 			auto operator()(std::shared_ptr<T> const& a, std::shared_ptr<T> const& b) const noexcept
 			   -> bool {
 				return *a < *b;
 			}
+			auto operator()(std::shared_ptr<T> const& a, T const& b) const noexcept -> bool {
+				return *a < b;
+			}
+			auto operator()(T const& a, std::shared_ptr<T> const& b) const noexcept -> bool {
+				return a < *b;
+			}
 		};
 
 		// struct edge_type = {ptr_src, ptr_dst, ptr_weight}
@@ -496,10 +1066,218 @@ namespace gdwg {
 			}
 		};
 
+		// every edge owns its weight
+		template<typename... Args>
+		static auto make_weight(Args&&... args) -> std::shared_ptr<E> {
+			GDWG_TRACE_SCOPE("allocation");
+			return std::make_shared<E>(std::forward<Args>(args)...);
+		}
+
+		// the one place edges are added: look the nodes up once and emplace once ==> a single search
+		// of all_edges_. The weight is already constructed, so no further copy of E is made
+		auto emplace_edge_ptr(N const& src,
+		                      N const& dst,
+		                      std::shared_ptr<E> weight_ptr,
+		                      std::string_view caller)
+		   -> std::pair<typename std::set<edge_type>::const_iterator, bool> {
+			GDWG_TRACE_PHASES("lookup");
+			auto const it_src = nodes_.find(src);
+			auto const it_dst = nodes_.find(dst);
+			if (it_src == nodes_.end() or it_dst == nodes_.end()) {
+				throw std::runtime_error(fmt::format("Cannot call gdwg::graph<N, E>::{} when either "
+				                                     "src or dst node does not exist",
+				                                     caller));
+			}
+			// initialize min_weight and max_weight for first edge, in case that <E> may not have a
+			// default constructor
+			if (all_edges_.empty()) {
+				min_weight_ = *weight_ptr;
+				max_weight_ = *weight_ptr;
+			}
+			GDWG_TRACE_NEXT_PHASE("rebalance");
+			auto const result = all_edges_.emplace(edge_type{*it_src, *it_dst, std::move(weight_ptr)});
+			// new edge already exist ==> nothing else to do
+			if (not result.second) {
+				return result;
+			}
+			GDWG_TRACE_NEXT_PHASE("indexes");
+			filter_insert(*result.first);
+			index_insert(result.first);
+			invalidate_source(src);
+			// private helper function: update min_weight_ and max_weight
+			update_weight_limits(*result.first->weight);
+			return result;
+		}
+
+		// the stored (src, dst) nodes of every edge of values, or throw with message if one isn't a
+		// node. Consecutive edges from the same src share one lookup
+		template<typename R>
+		auto node_ptrs_of(R const& values, std::string_view message) const
+		   -> std::vector<std::pair<std::shared_ptr<N>, std::shared_ptr<N>>> {
+			auto result = std::vector<std::pair<std::shared_ptr<N>, std::shared_ptr<N>>>{};
+			for (value_type const& value : values) {
+				auto ptr_src = std::shared_ptr<N>{};
+				if (not result.empty() and *result.back().first == value.from) {
+					ptr_src = result.back().first;
+				}
+				else if (auto const it = nodes_.find(value.from); it != nodes_.end()) {
+					ptr_src = *it;
+				}
+				auto const it_dst = nodes_.find(value.to);
+				if (not ptr_src or it_dst == nodes_.end()) {
+					throw std::runtime_error(fmt::format("Cannot call gdwg::graph<N, E>::{}", message));
+				}
+				result.emplace_back(std::move(ptr_src), *it_dst);
+			}
+			return result;
+		}
+
+		// throw if old_data doesn't exist, false if new_data already exists
+		auto can_replace_node(N const& old_data, N const& new_data) const -> bool {
+			if (not is_node(old_data)) {
+				throw std::runtime_error("Cannot call gdwg::graph<N, E>::replace_node on a node that "
+				                         "doesn't exist");
+			}
+			return not is_node(new_data);
+		}
+
 		// access the inner pointer of iterator: inner pointer = pointer to this.all_edges_
 		auto get_inner(iterator& i) -> typename std::set<edge_type>::const_iterator {
 			return i.inner_;
 		}
+		using edge_set_iterator = typename std::set<edge_type>::const_iterator;
+
+		// orders iterators into all_edges_ by (src, weight, dst) of their edges.
+		// Transparent: a bare src finds the whole range of its out-edges
+		struct compare_by_src_weight {
+			using is_transparent = void;
+
+			auto operator()(edge_set_iterator const& a, edge_set_iterator const& b) const -> bool {
+				if (*a->src == *b->src) {
+					if (*a->weight == *b->weight) {
+						return *a->dst < *b->dst;
+					}
+					return *a->weight < *b->weight;
+				}
+				return *a->src < *b->src;
+			}
+			auto operator()(edge_set_iterator const& a, N const& b) const -> bool {
+				return *a->src < b;
+			}
+			auto operator()(N const& a, edge_set_iterator const& b) const -> bool {
+				return a < *b->src;
+			}
+		};
+
+		// orders iterators into all_edges_ by (weight, src, dst). Transparent on the weight
+		struct compare_by_weight {
+			using is_transparent = void;
+
+			auto operator()(edge_set_iterator const& a, edge_set_iterator const& b) const -> bool {
+				if (*a->weight == *b->weight) {
+					if (*a->src == *b->src) {
+						return *a->dst < *b->dst;
+					}
+					return *a->src < *b->src;
+				}
+				return *a->weight < *b->weight;
+			}
+			auto operator()(edge_set_iterator const& a, E const& b) const -> bool {
+				return *a->weight < b;
+			}
+			auto operator()(E const& a, edge_set_iterator const& b) const -> bool {
+				return a < *b->weight;
+			}
+		};
+
+		// every erasure from all_edges_ goes through here, so that the index forgets the edge first
+		auto erase_at(edge_set_iterator it) -> edge_set_iterator {
+			index_erase(it);
+			return all_edges_.erase(it);
+		}
+		auto index_insert(edge_set_iterator it) -> void {
+			if (out_edges_by_weight_) {
+				out_edges_by_weight_->insert(it);
+			}
+			if (edges_by_weight_) {
+				edges_by_weight_->insert(it);
+			}
+		}
+		auto index_erase(edge_set_iterator it) -> void {
+			if (out_edges_by_weight_) {
+				out_edges_by_weight_->erase(it);
+			}
+			if (edges_by_weight_) {
+				edges_by_weight_->erase(it);
+			}
+		}
+
+		// the (weight, src, dst) index, built here on first use
+		auto weight_index() const -> std::set<edge_set_iterator, compare_by_weight>& {
+			if (not edges_by_weight_) {
+				GDWG_TRACE_SCOPE("index build");
+				edges_by_weight_.emplace();
+				for (auto it = all_edges_.begin(); it != all_edges_.end(); ++it) {
+					edges_by_weight_->insert(it);
+				}
+			}
+			return *edges_by_weight_;
+		}
+
+		// range of the out-edges of src in the (src, weight, dst) index, built here on first use
+		auto out_edges_of(N const& src, std::string_view caller) const
+		   -> std::pair<typename std::set<edge_set_iterator, compare_by_src_weight>::const_iterator,
+		                typename std::set<edge_set_iterator, compare_by_src_weight>::const_iterator> {
+			if (not is_node(src)) {
+				throw std::runtime_error(fmt::format("Cannot call gdwg::graph<N, E>::{} if src doesn't "
+				                                     "exist in the graph",
+				                                     caller));
+			}
+			if (not out_edges_by_weight_) {
+				GDWG_TRACE_SCOPE("index build");
+				out_edges_by_weight_.emplace();
+				for (auto it = all_edges_.begin(); it != all_edges_.end(); ++it) {
+					out_edges_by_weight_->insert(it);
+				}
+			}
+			return out_edges_by_weight_->equal_range(src);
+		}
+
+		// breadth first from start over the edges of weight <= max_weight, calling visit(node) on
+		// every node reached, start first, until it returns false. The out-edges of a node are one
+		// range of all_edges_ made of (src, dst) groups sorted by weight: a group whose first edge
+		// is too heavy is skipped whole
+		template<typename F>
+		auto search_with_max_weight(std::shared_ptr<N> const& start,
+		                            E const& max_weight,
+		                            F visit) const -> void {
+			if (not visit(start)) {
+				return;
+			}
+			if (all_edges_.empty()) {
+				return;
+			}
+			auto const lightest = std::make_shared<E>(min_weight_);
+			auto const heaviest = std::make_shared<E>(max_weight_);
+			auto const& first_node = *nodes_.begin();
+			auto seen = std::set<N const*>{start.get()};
+			auto queue = std::vector<std::shared_ptr<N>>{start};
+			for (auto i = std::size_t{0}; i < queue.size(); ++i) {
+				auto const u = queue[i];
+				auto it = all_edges_.lower_bound(edge_type{u, first_node, lightest});
+				while (it != all_edges_.end() and it->src == u) {
+					auto const& v = it->dst;
+					if (not(max_weight < *it->weight) and seen.insert(v.get()).second) {
+						if (not visit(v)) {
+							return;
+						}
+						queue.push_back(v);
+					}
+					it = all_edges_.upper_bound(edge_type{u, v, heaviest});
+				}
+			}
+		}
+
 		// helper function to maintain max_weight_ and min_weight_ at every insertion of edge
 		auto update_weight_limits(E const& weight) -> void {
 			if (weight > max_weight_) {
@@ -510,6 +1288,72 @@ namespace gdwg {
 			}
 		}
 
+		// the edge filter hashes the addresses of the stored src and dst nodes, which are stable for
+		// as long as the nodes are in the graph ==> works for any N, hashable or not
+		[[nodiscard]] auto filter_may_contain(std::shared_ptr<N> const& src,
+		                                      std::shared_ptr<N> const& dst) const noexcept -> bool {
+			return edge_filter_.empty()
+			       or edge_filter_.may_contain(
+			          detail::blocked_bloom_filter::hash_pair(src.get(), dst.get()));
+		}
+		auto filter_insert(edge_type const& edge) -> void {
+			if (edge_filter_.empty()) {
+				return;
+			}
+			// too many keys for the current size ==> grow instead of degrading
+			if (all_edges_.size() > edge_filter_.capacity()) {
+				filter_rebuild(2 * all_edges_.size());
+				return;
+			}
+			edge_filter_.insert(
+			   detail::blocked_bloom_filter::hash_pair(edge.src.get(), edge.dst.get()));
+		}
+		// erased edges cannot be removed from a bloom filter: count them and rebuild lazily
+		auto filter_note_erased(std::size_t count) -> void {
+			if (edge_filter_.empty()) {
+				return;
+			}
+			edge_filter_stale_ += count;
+			if (edge_filter_stale_ > edge_filter_.capacity() / 2) {
+				filter_rebuild(edge_filter_.capacity());
+			}
+		}
+		auto filter_rebuild(std::size_t expected_edges) -> void {
+			GDWG_TRACE_SCOPE("edge filter rebuild");
+			edge_filter_ = detail::blocked_bloom_filter(expected_edges);
+			edge_filter_stale_ = 0;
+			for (auto const& edge : all_edges_) {
+				edge_filter_.insert(
+				   detail::blocked_bloom_filter::hash_pair(edge.src.get(), edge.dst.get()));
+			}
+		}
+
+		// weights_cache_ is keyed by (src, dst) but can also be searched by src alone, so that all
+		// the cached weights of one source are dropped with a single erase(src)
+		struct compare_by_src {
+			using is_transparent = void;
+
+			auto operator()(std::pair<N, N> const& a, std::pair<N, N> const& b) const -> bool {
+				return a < b;
+			}
+			auto operator()(std::pair<N, N> const& a, N const& b) const -> bool {
+				return a.first < b;
+			}
+			auto operator()(N const& a, std::pair<N, N> const& b) const -> bool {
+				return a < b.first;
+			}
+		};
+		using weights_cache_type = detail::lru_cache<std::pair<N, N>, std::vector<E>, compare_by_src>;
+
+		// called by every modifier with the source of each edge it adds, removes or rewrites
+		auto invalidate_source(N const& src) -> void {
+			if (connections_cache_.capacity() == 0) {
+				return;
+			}
+			connections_cache_.erase(src);
+			weights_cache_.erase(src);
+		}
+
 		std::set<edge_type> all_edges_;
 
 		std::set<std::shared_ptr<N>, compare_ptr_by_content<N>> nodes_;
@@ -522,6 +1366,20 @@ namespace gdwg {
 		E min_weight_;
 		E max_weight_;
 
+		// empty unless enable_edge_filter() was called
+		detail::blocked_bloom_filter edge_filter_;
+		std::size_t edge_filter_stale_ = 0;
+
+		// disabled (capacity 0) unless enable_query_cache() was called
+		mutable detail::lru_cache<N, std::vector<N>> connections_cache_;
+		mutable weights_cache_type weights_cache_;
+
+		// built by the first k_lightest_out_edges / k_heaviest_out_edges, then kept up to date
+		mutable std::optional<std::set<edge_set_iterator, compare_by_src_weight>>
+		   out_edges_by_weight_;
+		// built by the first weight range query or pruning, then kept up to date
+		mutable std::optional<std::set<edge_set_iterator, compare_by_weight>> edges_by_weight_;
+
 	}; // namespace gdwg
 } // namespace gdwg
 
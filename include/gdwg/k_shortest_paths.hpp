@@ -0,0 +1,338 @@
+#ifndef GDWG_K_SHORTEST_PATHS_HPP
+#define GDWG_K_SHORTEST_PATHS_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <gdwg/detail/csr.hpp>
+#include <gdwg/detail/parallel.hpp>
+#include <gdwg/graph.hpp>
+#include <optional>
+#include <queue>
+#include <set>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace gdwg {
+	namespace detail {
+		// shortest distance from every node to target, std::nullopt where target is unreachable:
+		// Dijkstra on the reversed graph
+		template<typename N, typename E>
+		auto distances_to(csr<N, E> const& reversed, std::size_t target)
+		   -> std::vector<std::optional<E>> {
+			auto result = std::vector<std::optional<E>>(reversed.size());
+			auto queue = std::priority_queue<std::pair<E, std::size_t>,
+			                                 std::vector<std::pair<E, std::size_t>>,
+			                                 std::greater<>>{};
+			result[target] = E{};
+			queue.emplace(E{}, target);
+			while (not queue.empty()) {
+				auto const [d, v] = queue.top();
+				queue.pop();
+				if (*result[v] < d) {
+					continue;
+				}
+				for (auto e = reversed.offsets[v]; e < reversed.offsets[v + 1]; ++e) {
+					auto const u = reversed.targets[e];
+					auto const candidate = d + reversed.weights[e];
+					if (not result[u] or candidate < *result[u]) {
+						result[u] = candidate;
+						queue.emplace(candidate, u);
+					}
+				}
+			}
+			return result;
+		}
+
+		// the node edge e leaves: the last u with offsets[u] <= e
+		template<typename N, typename E>
+		auto source_of(csr<N, E> const& c, std::size_t e) -> std::size_t {
+			auto const it = std::upper_bound(c.offsets.begin(), c.offsets.end(), e);
+			return static_cast<std::size_t>(it - c.offsets.begin()) - 1;
+		}
+
+		// the buffers of one spur path search, sized once and reused by every search of a worker.
+		// Every search bumps a generation instead of clearing them: an entry is only valid when
+		// its stamp equals the current generation
+		template<typename N, typename E>
+		class spur_search {
+		public:
+			spur_search(std::size_t nodes, std::size_t edges)
+			: seen_(nodes, 0)
+			, closed_(nodes, 0)
+			, blocked_node_(nodes, 0)
+			, blocked_edge_(edges, 0)
+			, dist_(nodes)
+			, parent_edge_(nodes) {}
+
+			// the cheapest path from spur to target as edge ids, avoiding the blocked nodes and
+			// edges. A* guided by to_target, the exact distances without blocking: never more than
+			// the distances with blocking ==> the first time target is popped, its path is optimal
+			auto run(csr<N, E> const& c,
+			         std::vector<std::optional<E>> const& to_target,
+			         std::size_t spur,
+			         std::size_t target,
+			         std::vector<std::size_t> const& blocked_nodes,
+			         std::vector<std::size_t> const& blocked_edges)
+			   -> std::optional<std::pair<E, std::vector<std::size_t>>> {
+				if (++generation_ == 0) {
+					// wrapped around ==> the stamps of 2^32 searches ago would look current
+					for (auto* stamps : {&seen_, &closed_, &blocked_node_, &blocked_edge_}) {
+						std::fill(stamps->begin(), stamps->end(), 0);
+					}
+					generation_ = 1;
+				}
+				for (auto const v : blocked_nodes) {
+					blocked_node_[v] = generation_;
+				}
+				for (auto const e : blocked_edges) {
+					blocked_edge_[e] = generation_;
+				}
+				if (not to_target[spur]) {
+					return std::nullopt;
+				}
+				heap_.clear();
+				visit(spur, E{}, no_edge);
+				heap_.emplace_back(*to_target[spur], spur);
+				while (not heap_.empty()) {
+					std::pop_heap(heap_.begin(), heap_.end(), std::greater<>{});
+					auto const u = heap_.back().second;
+					heap_.pop_back();
+					if (closed_[u] == generation_) {
+						continue;
+					}
+					closed_[u] = generation_;
+					if (u == target) {
+						return std::pair(dist_[u], path_to(c, u));
+					}
+					for (auto e = c.offsets[u]; e < c.offsets[u + 1]; ++e) {
+						auto const v = c.targets[e];
+						if (blocked_edge_[e] == generation_ or blocked_node_[v] == generation_
+						    or not to_target[v] or closed_[v] == generation_)
+						{
+							continue;
+						}
+						auto const candidate = dist_[u] + c.weights[e];
+						if (seen_[v] != generation_ or candidate < dist_[v]) {
+							visit(v, candidate, e);
+							heap_.emplace_back(candidate + *to_target[v], v);
+							std::push_heap(heap_.begin(), heap_.end(), std::greater<>{});
+						}
+					}
+				}
+				return std::nullopt;
+			}
+
+		private:
+			static constexpr auto no_edge = static_cast<std::size_t>(-1);
+
+			auto visit(std::size_t v, E const& dist, std::size_t edge) -> void {
+				seen_[v] = generation_;
+				dist_[v] = dist;
+				parent_edge_[v] = edge;
+			}
+
+			auto path_to(csr<N, E> const& c, std::size_t v) const -> std::vector<std::size_t> {
+				auto result = std::vector<std::size_t>{};
+				for (auto e = parent_edge_[v]; e != no_edge; e = parent_edge_[source_of(c, e)]) {
+					result.push_back(e);
+				}
+				std::reverse(result.begin(), result.end());
+				return result;
+			}
+
+			std::uint32_t generation_ = 0;
+			std::vector<std::uint32_t> seen_;
+			std::vector<std::uint32_t> closed_;
+			std::vector<std::uint32_t> blocked_node_;
+			std::vector<std::uint32_t> blocked_edge_;
+			std::vector<E> dist_;
+			std::vector<std::size_t> parent_edge_;
+			std::vector<std::pair<E, std::size_t>> heap_;
+		};
+	} // namespace detail
+
+	namespace detail {
+		// Yen's algorithm on a snapshot c and its transpose reversed: every path after the first
+		// branches off an earlier one at a spur node, after the same root, then takes the shortest
+		// path to t avoiding the root and the edges the earlier paths with that root took next. The
+		// distances to t are computed once by a Dijkstra on reversed and guide every search as an
+		// A* heuristic, exact for the first path and never too high once nodes and edges are
+		// blocked. The spur searches of one path are independent and run on workers threads, each
+		// reusing its own buffers. Returns the paths as edge ids
+		template<typename N, typename E>
+		auto yen(csr<N, E> const& c,
+		         csr<N, E> const& reversed,
+		         std::size_t s,
+		         std::size_t t,
+		         std::size_t k,
+		         std::size_t workers) -> std::vector<std::vector<std::size_t>> {
+			using path = std::vector<std::size_t>;
+			auto const to_target = distances_to(reversed, t);
+			if (k == 0 or not to_target[s]) {
+				return {};
+			}
+
+			auto searches = std::vector<spur_search<N, E>>(
+			   workers,
+			   spur_search<N, E>(c.size(), c.targets.size()));
+			// guided by the exact distances ==> only ever leaves the shortest paths to break ties
+			auto accepted = std::vector<path>{searches[0].run(c, to_target, s, t, {}, {})->second};
+			// ordered by cost, then edge ids ==> the same path found twice is kept once
+			auto candidates = std::set<std::pair<E, path>>{};
+			while (accepted.size() < k) {
+				auto const& last = accepted.back();
+				auto nodes = std::vector<std::size_t>{s};
+				auto root_cost = std::vector<E>{E{}};
+				for (auto const e : last) {
+					nodes.push_back(c.targets[e]);
+					root_cost.push_back(root_cost.back() + c.weights[e]);
+				}
+
+				auto found = std::vector<std::optional<std::pair<E, path>>>(last.size());
+				auto const spur_at = [&](std::size_t i, std::size_t worker) {
+					auto const root_end = last.begin() + static_cast<std::ptrdiff_t>(i);
+					auto const root_nodes = nodes.begin() + static_cast<std::ptrdiff_t>(i);
+					auto const blocked_nodes = std::vector<std::size_t>(nodes.begin(), root_nodes);
+					auto blocked_edges = std::vector<std::size_t>{};
+					for (auto const& p : accepted) {
+						if (p.size() > i and std::equal(last.begin(), root_end, p.begin())) {
+							blocked_edges.push_back(p[i]);
+						}
+					}
+					auto spur =
+					   searches[worker].run(c, to_target, nodes[i], t, blocked_nodes, blocked_edges);
+					if (spur) {
+						auto edges = path(last.begin(), root_end);
+						edges.insert(edges.end(), spur->second.begin(), spur->second.end());
+						found[i] = std::pair(root_cost[i] + spur->first, std::move(edges));
+					}
+				};
+				for_each_index(last.size(), std::min(workers, last.size()), spur_at);
+				for (auto& candidate : found) {
+					if (candidate) {
+						candidates.insert(std::move(*candidate));
+					}
+				}
+				if (candidates.empty()) {
+					break;
+				}
+				accepted.push_back(std::move(candidates.extract(candidates.begin()).value().second));
+			}
+			return accepted;
+		}
+
+		// below a few thousand nodes, starting threads costs more than it saves
+		inline auto spur_workers(std::size_t threads, std::size_t nodes) -> std::size_t {
+			return nodes < 4096 ? std::size_t{1} : thread_count(threads, nodes);
+		}
+
+		// edge ids of c ==> iterators of g, found one by one: O(log e) for every edge of the paths
+		// instead of a walk over all the edges of g
+		template<typename N, typename E>
+		auto to_iterators(graph<N, E> const& g,
+		                  csr<N, E> const& c,
+		                  std::vector<std::vector<std::size_t>> const& paths)
+		   -> std::vector<std::vector<typename graph<N, E>::iterator>> {
+			auto result = std::vector<std::vector<typename graph<N, E>::iterator>>{};
+			result.reserve(paths.size());
+			for (auto const& p : paths) {
+				auto& edges = result.emplace_back();
+				edges.reserve(p.size());
+				// the edges of a path are chained ==> only the first source is searched for
+				auto src = p.empty() ? std::size_t{0} : source_of(c, p.front());
+				for (auto const e : p) {
+					auto const dst = c.targets[e];
+					edges.push_back(g.find(c.nodes[src], c.nodes[dst], c.weights[e]));
+					src = dst;
+				}
+			}
+			return result;
+		}
+
+		template<typename E>
+		auto has_negative(std::vector<E> const& weights) -> bool {
+			return std::any_of(weights.begin(), weights.end(), [](E const& w) { return w < E{}; });
+		}
+	} // namespace detail
+
+	// the k shortest simple paths from src to dst, shortest first, each as the iterators of its
+	// edges (empty for the path from src to itself). Fewer if there aren't k of them. Parallel
+	// edges make distinct paths. Weights must be non-negative. The spur searches run on threads
+	// threads (0 ==> one per core), see detail::yen.
+	//
+	// Every call snapshots the graph and its reverse, O(n + e log n): to query one graph many
+	// times, build a k_shortest_paths_finder once instead.
+	//
+	// The iterators are invalidated like any other graph<N, E>::iterator
+	template<typename N, typename E>
+	requires std::is_arithmetic_v<E> auto k_shortest_paths(graph<N, E> const& g,
+	                                                       N const& src,
+	                                                       N const& dst,
+	                                                       std::size_t k,
+	                                                       std::size_t threads = 0)
+	   -> std::vector<std::vector<typename graph<N, E>::iterator>> {
+		auto const c = detail::to_csr(g);
+		auto const s = c.id_of(src);
+		auto const t = c.id_of(dst);
+		if (not s or not t) {
+			throw std::runtime_error("Cannot call gdwg::k_shortest_paths if src or dst doesn't exist "
+			                         "in the graph");
+		}
+		if (detail::has_negative(c.weights)) {
+			throw std::runtime_error("Cannot call gdwg::k_shortest_paths on a graph with negative "
+			                         "weights");
+		}
+		auto const workers = detail::spur_workers(threads, c.size());
+		auto const paths = detail::yen(c, detail::transposed(c), *s, *t, k, workers);
+		return detail::to_iterators(g, c, paths);
+	}
+
+	// k_shortest_paths() for many queries on one graph: the snapshot of the graph and of its
+	// reverse are built once at construction and shared by every query, which then costs the
+	// Dijkstra to dst and the spur searches only.
+	//
+	// Like dag_executor, later changes of the graph are not reflected: rebuild the finder after
+	// them. The graph must outlive the finder
+	template<typename N, typename E>
+	requires std::is_arithmetic_v<E> class k_shortest_paths_finder {
+	public:
+		using iterator = typename graph<N, E>::iterator;
+
+		// threads = 0 ==> one per core
+		explicit k_shortest_paths_finder(graph<N, E> const& g, std::size_t threads = 0)
+		: graph_{&g}
+		, forward_{detail::to_csr(g)}
+		, reversed_{detail::transposed(forward_)}
+		, workers_{detail::spur_workers(threads, forward_.size())} {
+			if (detail::has_negative(forward_.weights)) {
+				throw std::runtime_error("Cannot create gdwg::k_shortest_paths_finder<N, E> from a "
+				                         "graph with negative weights");
+			}
+		}
+
+		// same as k_shortest_paths(g, src, dst, k)
+		[[nodiscard]] auto paths(N const& src, N const& dst, std::size_t k) const
+		   -> std::vector<std::vector<iterator>> {
+			auto const s = forward_.id_of(src);
+			auto const t = forward_.id_of(dst);
+			if (not s or not t) {
+				throw std::runtime_error("Cannot call gdwg::k_shortest_paths_finder<N, E>::paths if "
+				                         "src or dst doesn't exist in the graph");
+			}
+			auto const found = detail::yen(forward_, reversed_, *s, *t, k, workers_);
+			return detail::to_iterators(*graph_, forward_, found);
+		}
+
+	private:
+		graph<N, E> const* graph_;
+		detail::csr<N, E> forward_;
+		detail::csr<N, E> reversed_;
+		std::size_t workers_;
+	};
+} // namespace gdwg
+
+#endif // GDWG_K_SHORTEST_PATHS_HPP
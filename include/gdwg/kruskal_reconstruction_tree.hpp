@@ -0,0 +1,171 @@
+#ifndef GDWG_KRUSKAL_RECONSTRUCTION_TREE_HPP
+#define GDWG_KRUSKAL_RECONSTRUCTION_TREE_HPP
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <gdwg/graph.hpp>
+#include <numeric>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace gdwg {
+	// an offline index of weight-bounded connectivity, answering in O(log n) whether a and b are
+	// joined by a path whose edges all weigh <= max_weight.
+	//
+	// The edges are treated as UNDIRECTED: a path may use an edge against its direction. For the
+	// directed question use graph<N, E>::reachable_with_max_weight, a search per query.
+	//
+	// Kruskal's algorithm on the edges sorted by weight, where every union of two components
+	// creates a new tree node carrying the weight of the edge: the n nodes of the graph are the
+	// leaves, and the weights never decrease going up. So a and b are connected with edges of
+	// weight <= w iff their lowest common ancestor weighs <= w, found by binary lifting. The index
+	// is a snapshot: later changes of the graph are not reflected
+	template<typename N, typename E>
+	class kruskal_reconstruction_tree {
+	public:
+		// O(e log e + n log n)
+		explicit kruskal_reconstruction_tree(graph<N, E> const& g)
+		: nodes_{g.nodes()} {
+			auto const n = nodes_.size();
+			struct edge {
+				E weight;
+				std::size_t a;
+				std::size_t b;
+			};
+			auto const position = [this](N const& value) {
+				return static_cast<std::size_t>(std::lower_bound(nodes_.begin(), nodes_.end(), value)
+				                                - nodes_.begin());
+			};
+			auto edges = std::vector<edge>{};
+			for (auto const& [from, to, weight] : g) {
+				edges.push_back({weight, position(from), position(to)});
+			}
+			std::stable_sort(edges.begin(), edges.end(), [](edge const& x, edge const& y) {
+				return x.weight < y.weight;
+			});
+
+			// union-find over the tree nodes: a component is named by its tree root
+			parent_.resize(n);
+			std::iota(parent_.begin(), parent_.end(), std::size_t{0});
+			auto component = parent_;
+			auto const find = [&component](std::size_t x) {
+				while (component[x] != x) {
+					component[x] = component[component[x]];
+					x = component[x];
+				}
+				return x;
+			};
+			weight_.resize(n);
+			for (auto const& e : edges) {
+				auto const a = find(e.a);
+				auto const b = find(e.b);
+				if (a == b) {
+					continue;
+				}
+				auto const joined = parent_.size();
+				parent_.push_back(joined);
+				component.push_back(joined);
+				weight_.push_back(e.weight);
+				parent_[a] = parent_[b] = joined;
+				component[a] = component[b] = joined;
+			}
+
+			// a parent is always created after its children ==> depths top down in reverse
+			auto const size = parent_.size();
+			depth_.assign(size, 0);
+			for (auto x = size; x-- > 0;) {
+				if (parent_[x] != x) {
+					depth_[x] = depth_[parent_[x]] + 1;
+				}
+			}
+			levels_ = static_cast<std::size_t>(std::bit_width(size));
+			up_.assign(levels_ * size, 0);
+			for (auto x = std::size_t{0}; x < size; ++x) {
+				up_[x] = parent_[x];
+			}
+			for (auto j = std::size_t{1}; j < levels_; ++j) {
+				for (auto x = std::size_t{0}; x < size; ++x) {
+					up_[j * size + x] = up_[(j - 1) * size + up_[(j - 1) * size + x]];
+				}
+			}
+		}
+
+		// whether a path of edges of weight <= max_weight joins a and b, ignoring directions.
+		// Every node is connected to itself. O(log n)
+		[[nodiscard]] auto
+		connected_with_max_weight(N const& a, N const& b, E const& max_weight) const -> bool {
+			auto const x = id_of(a, "connected_with_max_weight");
+			auto const y = id_of(b, "connected_with_max_weight");
+			if (x == y) {
+				return true;
+			}
+			auto const w = bottleneck_of(x, y);
+			return w and not(max_weight < *w);
+		}
+
+		// the smallest max_weight for which a and b are connected: the lightest possible heaviest
+		// edge of a path between them. std::nullopt if they are never connected, and for a == b
+		[[nodiscard]] auto bottleneck(N const& a, N const& b) const -> std::optional<E> {
+			auto const x = id_of(a, "bottleneck");
+			auto const y = id_of(b, "bottleneck");
+			if (x == y) {
+				return std::nullopt;
+			}
+			return bottleneck_of(x, y);
+		}
+
+	private:
+		auto id_of(N const& value, char const* caller) const -> std::size_t {
+			auto const it = std::lower_bound(nodes_.begin(), nodes_.end(), value);
+			if (it == nodes_.end() or not(*it == value)) {
+				throw std::runtime_error(std::string("Cannot call gdwg::kruskal_reconstruction_tree<N, "
+				                                     "E>::")
+				                         + caller + " on a node that doesn't exist in the graph");
+			}
+			return static_cast<std::size_t>(it - nodes_.begin());
+		}
+
+		// the weight of the lowest common ancestor of two different leaves, std::nullopt if they
+		// are in different trees
+		auto bottleneck_of(std::size_t x, std::size_t y) const -> std::optional<E> {
+			auto const size = parent_.size();
+			if (depth_[x] < depth_[y]) {
+				std::swap(x, y);
+			}
+			for (auto j = std::size_t{0}, diff = depth_[x] - depth_[y]; diff != 0; ++j, diff >>= 1U) {
+				if ((diff & 1U) != 0) {
+					x = up_[j * size + x];
+				}
+			}
+			if (x == y) {
+				return weight_[x];
+			}
+			for (auto j = levels_; j-- > 0;) {
+				auto const ax = up_[j * size + x];
+				auto const ay = up_[j * size + y];
+				if (ax != ay) {
+					x = ax;
+					y = ay;
+				}
+			}
+			if (parent_[x] != parent_[y]) {
+				return std::nullopt;
+			}
+			return weight_[parent_[x]];
+		}
+
+		std::vector<N> nodes_;
+		// tree nodes: the graph nodes 0 .. n - 1, then one per union. A root is its own parent
+		std::vector<std::size_t> parent_;
+		std::vector<E> weight_;
+		std::vector<std::size_t> depth_;
+		// up_[j * size + x] = the 2^j-th ancestor of x, stopping at its root
+		std::size_t levels_ = 0;
+		std::vector<std::size_t> up_;
+	};
+} // namespace gdwg
+
+#endif // GDWG_KRUSKAL_RECONSTRUCTION_TREE_HPP
@@ -0,0 +1,416 @@
+#ifndef GDWG_LATENCY_HPP
+#define GDWG_LATENCY_HPP
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <fmt/format.h>
+#include <limits>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// latency of the public members of gdwg::graph, recorded when GDWG_ENABLE_LATENCY is defined.
+//
+// Every thread records into its own histograms (one per operation), so recording never waits for
+// another thread. snapshot() merges the histograms of every thread that ever recorded, and the
+// result can be exported with to_text() / to_json(). Only the outermost public call of a thread is
+// recorded: the is_node() done by insert_node() is part of insert_node().
+namespace gdwg::latency {
+	enum class operation : std::size_t {
+		insert_node,
+		emplace_node,
+		insert_edge,
+		emplace_edge,
+		try_insert_edge,
+		insert_edges,
+		replace_node,
+		merge_replace_node,
+		erase_node,
+		erase_nodes,
+		merge_replace_nodes,
+		erase_edge,
+		erase_edges,
+		erase_edges_with_weight_below,
+		update_weight,
+		is_node,
+		is_connected,
+		nodes,
+		weights,
+		find,
+		connections,
+		k_lightest_out_edges,
+		k_heaviest_out_edges,
+		edges_with_weight_in,
+		count_edges_with_weight_in,
+		reachable_with_max_weight,
+		equal,
+		print,
+	};
+
+	inline constexpr auto operation_names = std::array<std::string_view, 28>{
+	   "insert_node",
+	   "emplace_node",
+	   "insert_edge",
+	   "emplace_edge",
+	   "try_insert_edge",
+	   "insert_edges",
+	   "replace_node",
+	   "merge_replace_node",
+	   "erase_node",
+	   "erase_nodes",
+	   "merge_replace_nodes",
+	   "erase_edge",
+	   "erase_edges",
+	   "erase_edges_with_weight_below",
+	   "update_weight",
+	   "is_node",
+	   "is_connected",
+	   "nodes",
+	   "weights",
+	   "find",
+	   "connections",
+	   "k_lightest_out_edges",
+	   "k_heaviest_out_edges",
+	   "edges_with_weight_in",
+	   "count_edges_with_weight_in",
+	   "reachable_with_max_weight",
+	   "equal",
+	   "print",
+	};
+	static_assert(operation_names.size() == static_cast<std::size_t>(operation::print) + 1);
+
+	namespace detail {
+		class recorder;
+	} // namespace detail
+
+	// HDR style histogram of nanoseconds: values below 2^sub_bucket_bits are exact, larger ones
+	// fall in one of 2^sub_bucket_bits linear sub-buckets of their power of two ==> a relative
+	// error below 1 / 2^sub_bucket_bits, with a fixed and small number of counters
+	class histogram {
+	public:
+		static constexpr auto sub_bucket_bits = 4U;
+		static constexpr auto sub_buckets = std::uint64_t{1} << sub_bucket_bits;
+		// values of 2^max_exponent ns (18 minutes) and more all count as the largest bucket
+		static constexpr auto max_exponent = 40U;
+		static constexpr auto num_buckets =
+		   static_cast<std::size_t>((max_exponent - sub_bucket_bits + 1) * sub_buckets);
+
+		static constexpr auto bucket_of(std::uint64_t value) noexcept -> std::size_t {
+			value = std::min(value, (std::uint64_t{1} << max_exponent) - 1);
+			if (value < sub_buckets) {
+				return static_cast<std::size_t>(value);
+			}
+			auto const exponent = static_cast<unsigned>(std::bit_width(value)) - 1;
+			auto const shift = exponent - sub_bucket_bits;
+			auto const sub_bucket = (value >> shift) - sub_buckets;
+			return static_cast<std::size_t>((shift + 1) * sub_buckets + sub_bucket);
+		}
+
+		// the largest value counted in bucket
+		static constexpr auto highest_in(std::size_t bucket) noexcept -> std::uint64_t {
+			if (bucket < sub_buckets) {
+				return bucket;
+			}
+			auto const shift = bucket / sub_buckets - 1;
+			auto const sub_bucket = bucket % sub_buckets;
+			return ((sub_buckets + sub_bucket + 1) << shift) - 1;
+		}
+
+		auto record(std::uint64_t value) noexcept -> void {
+			++counts_[bucket_of(value)];
+			++count_;
+			sum_ += value;
+			min_ = std::min(min_, value);
+			max_ = std::max(max_, value);
+		}
+
+		auto merge(histogram const& other) noexcept -> void {
+			for (auto i = std::size_t{0}; i < num_buckets; ++i) {
+				counts_[i] += other.counts_[i];
+			}
+			count_ += other.count_;
+			sum_ += other.sum_;
+			min_ = std::min(min_, other.min_);
+			max_ = std::max(max_, other.max_);
+		}
+
+		[[nodiscard]] auto count() const noexcept -> std::uint64_t {
+			return count_;
+		}
+		[[nodiscard]] auto min() const noexcept -> std::uint64_t {
+			return count_ == 0 ? 0 : min_;
+		}
+		[[nodiscard]] auto max() const noexcept -> std::uint64_t {
+			return max_;
+		}
+		[[nodiscard]] auto mean() const noexcept -> double {
+			return count_ == 0 ? 0.0 : static_cast<double>(sum_) / static_cast<double>(count_);
+		}
+
+		// smallest recorded value v such that a fraction p of the values are <= v, up to the
+		// resolution of the buckets. p in [0, 1]
+		[[nodiscard]] auto percentile(double p) const noexcept -> std::uint64_t {
+			if (count_ == 0) {
+				return 0;
+			}
+			auto const exact = std::clamp(p, 0.0, 1.0) * static_cast<double>(count_);
+			auto const rank = std::max(std::uint64_t{1}, static_cast<std::uint64_t>(exact + 0.5));
+			auto seen = std::uint64_t{0};
+			for (auto i = std::size_t{0}; i < num_buckets; ++i) {
+				seen += counts_[i];
+				if (seen >= rank) {
+					return std::clamp(highest_in(i), min_, max_);
+				}
+			}
+			return max_;
+		}
+
+	private:
+		friend class detail::recorder;
+
+		std::array<std::uint64_t, num_buckets> counts_ = {};
+		std::uint64_t count_ = 0;
+		std::uint64_t sum_ = 0;
+		std::uint64_t min_ = std::numeric_limits<std::uint64_t>::max();
+		std::uint64_t max_ = 0;
+	};
+
+	struct operation_latency {
+		std::string_view operation;
+		histogram latency;
+	};
+
+	namespace detail {
+		// written by its thread only, read by snapshot(): relaxed atomics, without read-modify-write
+		class recorder {
+		public:
+			auto record(operation op, std::uint64_t value) noexcept -> void {
+				auto& counters = ops_[static_cast<std::size_t>(op)];
+				bump(counters.counts[histogram::bucket_of(value)], 1);
+				bump(counters.sum, value);
+				if (value < counters.min.load(std::memory_order_relaxed)) {
+					counters.min.store(value, std::memory_order_relaxed);
+				}
+				if (value > counters.max.load(std::memory_order_relaxed)) {
+					counters.max.store(value, std::memory_order_relaxed);
+				}
+			}
+
+			// result[op] += the histogram of op
+			auto merge_into(std::vector<histogram>& result) const noexcept -> void {
+				for (auto i = std::size_t{0}; i < ops_.size(); ++i) {
+					auto& h = result[i];
+					for (auto bucket = std::size_t{0}; bucket < histogram::num_buckets; ++bucket) {
+						auto const n = ops_[i].counts[bucket].load(std::memory_order_relaxed);
+						h.counts_[bucket] += n;
+						h.count_ += n;
+					}
+					h.sum_ += ops_[i].sum.load(std::memory_order_relaxed);
+					h.min_ = std::min(h.min_, ops_[i].min.load(std::memory_order_relaxed));
+					h.max_ = std::max(h.max_, ops_[i].max.load(std::memory_order_relaxed));
+				}
+			}
+
+			// racing with record() may keep a few of the values recorded meanwhile
+			auto reset() noexcept -> void {
+				for (auto& counters : ops_) {
+					for (auto& count : counters.counts) {
+						count.store(0, std::memory_order_relaxed);
+					}
+					counters.sum.store(0, std::memory_order_relaxed);
+					counters.min.store(std::numeric_limits<std::uint64_t>::max(),
+					                   std::memory_order_relaxed);
+					counters.max.store(0, std::memory_order_relaxed);
+				}
+			}
+
+		private:
+			struct counters_type {
+				std::array<std::atomic<std::uint64_t>, histogram::num_buckets> counts = {};
+				std::atomic<std::uint64_t> sum = 0;
+				std::atomic<std::uint64_t> min = std::numeric_limits<std::uint64_t>::max();
+				std::atomic<std::uint64_t> max = 0;
+			};
+
+			static auto bump(std::atomic<std::uint64_t>& counter, std::uint64_t by) noexcept -> void {
+				counter.store(counter.load(std::memory_order_relaxed) + by, std::memory_order_relaxed);
+			}
+
+			std::array<counters_type, operation_names.size()> ops_;
+		};
+
+		struct registry {
+			std::mutex mutex;
+			// the recorders of the running threads
+			std::vector<recorder*> live;
+			// the latencies of the threads that exited, merged: they stay in the snapshots
+			std::vector<histogram> retired = std::vector<histogram>(operation_names.size());
+		};
+
+		inline auto global() -> registry& {
+			static auto instance = registry{};
+			return instance;
+		}
+
+		// the recorder of one thread, registered by its first probe. When the thread exits, its
+		// latencies are merged into the retired ones and the recorder is released ==> the registry
+		// doesn't grow with threads that come and go
+		class thread_recorder {
+		public:
+			thread_recorder() {
+				auto& r = global();
+				auto const lock = std::lock_guard(r.mutex);
+				r.live.push_back(&recorder_);
+			}
+
+			thread_recorder(thread_recorder const&) = delete;
+			auto operator=(thread_recorder const&) -> thread_recorder& = delete;
+
+			~thread_recorder() {
+				auto& r = global();
+				auto const lock = std::lock_guard(r.mutex);
+				recorder_.merge_into(r.retired);
+				std::erase(r.live, &recorder_);
+			}
+
+			auto get() noexcept -> recorder& {
+				return recorder_;
+			}
+
+		private:
+			recorder recorder_;
+		};
+
+		inline auto local() -> recorder& {
+			thread_local auto instance = thread_recorder{};
+			return instance.get();
+		}
+
+		inline thread_local auto depth = 0U;
+		inline auto enabled = std::atomic<bool>{true};
+	} // namespace detail
+
+	// recording can also be switched off at run time, e.g. outside of an investigation
+	inline auto set_enabled(bool on) noexcept -> void {
+		detail::enabled.store(on, std::memory_order_relaxed);
+	}
+	[[nodiscard]] inline auto enabled() noexcept -> bool {
+		return detail::enabled.load(std::memory_order_relaxed);
+	}
+
+	// times the lifetime of the probe, if it is the outermost one of its thread
+	class probe {
+	public:
+		explicit probe(operation op) noexcept
+		: op_{op}
+		, outermost_{detail::depth++ == 0 and enabled()} {
+			if (outermost_) {
+				start_ = std::chrono::steady_clock::now();
+			}
+		}
+
+		probe(probe const&) = delete;
+		auto operator=(probe const&) -> probe& = delete;
+
+		~probe() {
+			--detail::depth;
+			if (outermost_) {
+				auto const elapsed = std::chrono::steady_clock::now() - start_;
+				detail::local().record(
+				   op_,
+				   static_cast<std::uint64_t>(
+				      std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count()));
+			}
+		}
+
+	private:
+		operation op_;
+		bool outermost_;
+		std::chrono::steady_clock::time_point start_;
+	};
+
+	// the histograms of every thread merged, for the operations recorded at least once
+	[[nodiscard]] inline auto snapshot() -> std::vector<operation_latency> {
+		auto merged = std::vector<histogram>(operation_names.size());
+		{
+			auto& r = detail::global();
+			auto const lock = std::lock_guard(r.mutex);
+			merged = r.retired;
+			for (auto* recorder : r.live) {
+				recorder->merge_into(merged);
+			}
+		}
+		auto result = std::vector<operation_latency>{};
+		for (auto i = std::size_t{0}; i < merged.size(); ++i) {
+			if (merged[i].count() != 0) {
+				result.push_back({operation_names[i], merged[i]});
+			}
+		}
+		return result;
+	}
+
+	// forget every recorded latency
+	inline auto reset() -> void {
+		auto& r = detail::global();
+		auto const lock = std::lock_guard(r.mutex);
+		for (auto* recorder : r.live) {
+			recorder->reset();
+		}
+		r.retired.assign(operation_names.size(), histogram{});
+	}
+
+	// one line per operation, latencies in ns
+	[[nodiscard]] inline auto to_text(std::vector<operation_latency> const& report) -> std::string {
+		auto result = fmt::format("{:<30} {:>10} {:>10} {:>10} {:>10} {:>10} {:>10} {:>10}\n",
+		                          "operation",
+		                          "count",
+		                          "min",
+		                          "p50",
+		                          "p99",
+		                          "p999",
+		                          "max",
+		                          "mean");
+		for (auto const& [name, h] : report) {
+			result += fmt::format("{:<30} {:>10} {:>10} {:>10} {:>10} {:>10} {:>10} {:>10.1f}\n",
+			                      name,
+			                      h.count(),
+			                      h.min(),
+			                      h.percentile(0.5),
+			                      h.percentile(0.99),
+			                      h.percentile(0.999),
+			                      h.max(),
+			                      h.mean());
+		}
+		return result;
+	}
+
+	// {"operation": {"count": .., "min_ns": .., "p50_ns": .., ...}, ...}
+	[[nodiscard]] inline auto to_json(std::vector<operation_latency> const& report) -> std::string {
+		auto result = std::string("{");
+		for (auto const& [name, h] : report) {
+			if (result.size() > 1) {
+				result += ",";
+			}
+			result += fmt::format(R"("{}":{{"count":{},"min_ns":{},"p50_ns":{},"p90_ns":{},)"
+			                      R"("p99_ns":{},"p999_ns":{},"max_ns":{},"mean_ns":{:.1f}}})",
+			                      name,
+			                      h.count(),
+			                      h.min(),
+			                      h.percentile(0.5),
+			                      h.percentile(0.9),
+			                      h.percentile(0.99),
+			                      h.percentile(0.999),
+			                      h.max(),
+			                      h.mean());
+		}
+		return result + "}";
+	}
+} // namespace gdwg::latency
+
+#endif // GDWG_LATENCY_HPP
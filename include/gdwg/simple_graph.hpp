@@ -0,0 +1,454 @@
+#ifndef GDWG_SIMPLE_GRAPH_HPP
+#define GDWG_SIMPLE_GRAPH_HPP
+
+#include <concepts/concepts.hpp>
+#include <cstddef>
+#include <fmt/format.h>
+#include <initializer_list>
+#include <iterator>
+#include <map>
+#include <optional>
+#include <ostream>
+#include <range/v3/algorithm.hpp>
+#include <range/v3/iterator.hpp>
+#include <range/v3/utility.hpp>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace gdwg {
+	namespace detail {
+		// the weight parameters of an unweighted graph: never passed, only there to keep the
+		// declarations of the weighted members valid
+		struct no_weight {
+			auto operator==(no_weight const&) const -> bool = default;
+		};
+
+		// dst -> weight, or only the set of dst when there is no weight to store
+		template<typename N, typename E>
+		struct simple_adjacency {
+			using type = std::map<N, E>;
+		};
+		template<typename N>
+		struct simple_adjacency<N, void> {
+			using type = std::set<N>;
+		};
+
+		template<typename N, typename E>
+		struct simple_edge {
+			N from;
+			N to;
+			E weight;
+		};
+		template<typename N>
+		struct simple_edge<N, void> {
+			N from;
+			N to;
+		};
+	} // namespace detail
+
+	// a directed graph with at most one edge per (src, dst), weighted by an E, or unweighted when
+	// E is void.
+	//
+	// graph<N, E> supports any number of edges between two nodes, so every edge is a
+	// (src, dst, weight) entry of its own and every weight lookup is a range search of them.
+	// Here an edge is one entry dst -> weight of the adjacency map of src: weight(src, dst) is a
+	// single lookup, O(log(n) + log(d)). With E = void the adjacency is a std::set of dst, and
+	// nothing is stored or compared for the weights. The members that take or return a weight
+	// only exist for a weighted graph
+	template<concepts::regular N, typename E = void>
+	requires concepts::totally_ordered<N> and (std::is_void_v<E> or concepts::regular<E>)
+	class simple_graph {
+	private:
+		using adjacency = typename detail::simple_adjacency<N, E>::type;
+		using node_map = std::map<N, adjacency>;
+
+	public:
+		class iterator;
+
+		static constexpr auto is_weighted = not std::is_void_v<E>;
+		using weight_type = std::conditional_t<is_weighted, E, detail::no_weight>;
+		using value_type = detail::simple_edge<N, E>;
+
+		simple_graph() noexcept = default;
+
+		simple_graph(std::initializer_list<N> il)
+		: simple_graph(il.begin(), il.end()) {}
+
+		template<ranges::forward_iterator I, ranges::sentinel_for<I> S>
+		requires ranges::indirectly_copyable<I, N*> simple_graph(I first, S last) {
+			ranges::for_each(first, last, [this](N const& n) { insert_node(n); });
+		}
+
+		template<ranges::forward_iterator I, ranges::sentinel_for<I> S>
+		requires ranges::indirectly_copyable<I, value_type*> simple_graph(I first, S last) {
+			ranges::for_each(first, last, [this](value_type const& v) {
+				insert_node(v.from);
+				insert_node(v.to);
+				insert(v);
+			});
+		}
+
+		//---------------------------- modifiers -----------------------------------------
+		auto insert_node(N const& value) -> bool {
+			return nodes_.try_emplace(value).second;
+		}
+
+		// false if src and dst are already connected
+		auto insert_edge(N const& src, N const& dst) -> bool requires(not is_weighted) {
+			if (not adjacency_of(*this, src, dst, insert_edge_error).insert(dst).second) {
+				return false;
+			}
+			++num_edges_;
+			return true;
+		}
+
+		// false if src and dst are already connected, whatever the weight. See update_weight
+		auto insert_edge(N const& src, N const& dst, weight_type const& weight)
+		   -> bool requires is_weighted {
+			auto& adjacent = adjacency_of(*this, src, dst, insert_edge_error);
+			if (not adjacent.try_emplace(dst, weight).second) {
+				return false;
+			}
+			++num_edges_;
+			return true;
+		}
+
+		// false if src and dst aren't connected
+		auto update_weight(N const& src, N const& dst, weight_type const& new_weight)
+		   -> bool requires is_weighted {
+			auto& adjacent = adjacency_of(*this,
+			                              src,
+			                              dst,
+			                              "update_weight if src or dst node don't exist in the graph");
+			auto const it = adjacent.find(dst);
+			if (it == adjacent.end()) {
+				return false;
+			}
+			it->second = new_weight;
+			return true;
+		}
+
+		auto replace_node(N const& old_data, N const& new_data) -> bool {
+			if (not is_node(old_data)) {
+				throw std::runtime_error("Cannot call gdwg::simple_graph<N, E>::replace_node on a node "
+				                         "that doesn't exist");
+			}
+			if (is_node(new_data)) {
+				return false;
+			}
+			insert_node(new_data);
+			merge_replace_node(old_data, new_data);
+			return true;
+		}
+
+		// an edge of old_data that collides with one of new_data is dropped: the edge already
+		// between the two nodes wins. O(n log(n)) like erase_node
+		auto merge_replace_node(N const& old_data, N const& new_data) -> void {
+			if (not is_node(old_data) or not is_node(new_data)) {
+				throw std::runtime_error("Cannot call gdwg::simple_graph<N, E>::merge_replace_node on "
+				                         "old or new data if they don't exist in the graph");
+			}
+			if (old_data == new_data) {
+				return;
+			}
+			auto moved = std::vector<value_type>{};
+			for (auto const& [src, adjacent] : nodes_) {
+				for (auto const& entry : adjacent) {
+					auto const& dst = target_of(entry);
+					if (src != old_data and dst != old_data) {
+						continue;
+					}
+					auto const& from = src == old_data ? new_data : src;
+					auto const& to = dst == old_data ? new_data : dst;
+					if constexpr (is_weighted) {
+						moved.push_back({from, to, entry.second});
+					}
+					else {
+						moved.push_back({from, to});
+					}
+				}
+			}
+			erase_node(old_data);
+			for (auto const& edge : moved) {
+				insert(edge);
+			}
+		}
+
+		// without an in-neighbour index: every adjacency is searched for value. O(n log(n))
+		auto erase_node(N const& value) -> bool {
+			auto const it = nodes_.find(value);
+			if (it == nodes_.end()) {
+				return false;
+			}
+			num_edges_ -= it->second.size();
+			nodes_.erase(it);
+			for (auto& [src, adjacent] : nodes_) {
+				num_edges_ -= adjacent.erase(value);
+			}
+			return true;
+		}
+
+		auto erase_edge(N const& src, N const& dst) -> bool {
+			auto& adjacent = adjacency_of(*this,
+			                              src,
+			                              dst,
+			                              "erase_edge on src or dst if they don't exist in the graph");
+			if (adjacent.erase(dst) == 0) {
+				return false;
+			}
+			--num_edges_;
+			return true;
+		}
+
+		auto clear() noexcept -> void {
+			nodes_.clear();
+			num_edges_ = 0;
+		}
+
+		//-------------------------------- Accessors --------------------------------------------
+		[[nodiscard]] auto is_node(N const& value) const -> bool {
+			return nodes_.contains(value);
+		}
+
+		[[nodiscard]] auto empty() const -> bool {
+			return nodes_.empty();
+		}
+
+		[[nodiscard]] auto is_connected(N const& src, N const& dst) const -> bool {
+			auto const& adjacent = adjacency_of(*this,
+			                                    src,
+			                                    dst,
+			                                    "is_connected if src or dst node don't exist in the "
+			                                    "graph");
+			return adjacent.contains(dst);
+		}
+
+		[[nodiscard]] auto nodes() const -> std::vector<N> {
+			auto result = std::vector<N>{};
+			result.reserve(nodes_.size());
+			for (auto const& [node, adjacent] : nodes_) {
+				result.push_back(node);
+			}
+			return result;
+		}
+
+		// the weight of the edge from src to dst, std::nullopt if they aren't connected
+		[[nodiscard]] auto weight(N const& src, N const& dst) const
+		   -> std::optional<weight_type> requires is_weighted {
+			auto const& adjacent =
+			   adjacency_of(*this, src, dst, "weight if src or dst node don't exist in the graph");
+			auto const it = adjacent.find(dst);
+			if (it == adjacent.end()) {
+				return std::nullopt;
+			}
+			return it->second;
+		}
+
+		[[nodiscard]] auto find(N const& src, N const& dst) const -> iterator {
+			auto const it_src = nodes_.find(src);
+			if (it_src == nodes_.end()) {
+				return end();
+			}
+			auto const it_dst = it_src->second.find(dst);
+			if (it_dst == it_src->second.end()) {
+				return end();
+			}
+			return iterator(it_src, nodes_.end(), it_dst);
+		}
+
+		// in ascending order
+		[[nodiscard]] auto connections(N const& src) const -> std::vector<N> {
+			auto const it_src = nodes_.find(src);
+			if (it_src == nodes_.end()) {
+				throw std::runtime_error("Cannot call gdwg::simple_graph<N, E>::connections if src "
+				                         "doesn't exist in the graph");
+			}
+			auto result = std::vector<N>{};
+			result.reserve(it_src->second.size());
+			for (auto const& entry : it_src->second) {
+				result.push_back(target_of(entry));
+			}
+			return result;
+		}
+
+		[[nodiscard]] auto num_edges() const noexcept -> std::size_t {
+			return num_edges_;
+		}
+
+		//--------------------------------- range access ------------------------------------
+		[[nodiscard]] auto begin() const -> iterator {
+			return iterator(nodes_.begin(), nodes_.end());
+		}
+
+		[[nodiscard]] auto end() const -> iterator {
+			return iterator(nodes_.end(), nodes_.end());
+		}
+
+		// ------------------------------ comparisons --------------------------------------
+		[[nodiscard]] auto operator==(simple_graph const& other) const -> bool {
+			return num_edges_ == other.num_edges_ and nodes_ == other.nodes_;
+		}
+
+		// ------------------------------ extractor ----------------------------------------
+		// the format of graph<N, E>, without the " | weight" of an unweighted graph
+		friend auto operator<<(std::ostream& os, simple_graph const& g) -> std::ostream& {
+			for (auto const& [node, adjacent] : g.nodes_) {
+				os << node << " (\n";
+				for (auto const& entry : adjacent) {
+					if constexpr (is_weighted) {
+						os << fmt::format("  {} | {}\n", entry.first, entry.second);
+					}
+					else {
+						os << fmt::format("  {}\n", entry);
+					}
+				}
+				os << ")\n";
+			}
+			return os;
+		}
+
+		// ------------------------------ Iterator -----------------------------------------
+		// bidirectional iterator over every edge, sorted by (src, dst). It yields (src, dst,
+		// weight) for a weighted graph and (src, dst) for an unweighted one
+		class iterator {
+		private:
+			using outer_iter = typename node_map::const_iterator;
+			using inner_iter = typename adjacency::const_iterator;
+
+		public:
+			using value_type = std::conditional_t<is_weighted,
+			                                      ranges::common_tuple<N, N, weight_type>,
+			                                      ranges::common_tuple<N, N>>;
+			using reference =
+			   std::conditional_t<is_weighted,
+			                      ranges::common_tuple<N const&, N const&, weight_type const&>,
+			                      ranges::common_tuple<N const&, N const&>>;
+			using difference_type = std::ptrdiff_t;
+			using iterator_category = std::bidirectional_iterator_tag;
+
+			iterator() = default;
+
+			auto operator*() const -> reference {
+				if constexpr (is_weighted) {
+					return reference{outer_->first, inner_->first, inner_->second};
+				}
+				else {
+					return reference{outer_->first, *inner_};
+				}
+			}
+
+			auto operator++() -> iterator& {
+				++inner_;
+				skip_empty();
+				return *this;
+			}
+			auto operator++(int) -> iterator {
+				auto temp = *this;
+				++*this;
+				return temp;
+			}
+
+			// never called on begin(): there is always an edge before
+			auto operator--() -> iterator& {
+				while (outer_ == outer_end_ or inner_ == outer_->second.begin()) {
+					--outer_;
+					inner_ = outer_->second.end();
+				}
+				--inner_;
+				return *this;
+			}
+			auto operator--(int) -> iterator {
+				auto temp = *this;
+				--*this;
+				return temp;
+			}
+
+			auto operator==(iterator const& other) const -> bool {
+				if (outer_ != other.outer_) {
+					return false;
+				}
+				return outer_ == outer_end_ or inner_ == other.inner_;
+			}
+
+		private:
+			friend class simple_graph;
+
+			// first edge at or after outer
+			iterator(outer_iter outer, outer_iter outer_end)
+			: outer_{outer}
+			, outer_end_{outer_end} {
+				if (outer_ != outer_end_) {
+					inner_ = outer_->second.begin();
+					skip_empty();
+				}
+			}
+
+			iterator(outer_iter outer, outer_iter outer_end, inner_iter inner)
+			: outer_{outer}
+			, outer_end_{outer_end}
+			, inner_{inner} {}
+
+			auto skip_empty() -> void {
+				while (inner_ == outer_->second.end()) {
+					++outer_;
+					if (outer_ == outer_end_) {
+						return;
+					}
+					inner_ = outer_->second.begin();
+				}
+			}
+
+			outer_iter outer_;
+			outer_iter outer_end_;
+			inner_iter inner_;
+		};
+
+	private:
+		static auto target_of(typename adjacency::value_type const& entry) -> N const& {
+			if constexpr (is_weighted) {
+				return entry.first;
+			}
+			else {
+				return entry;
+			}
+		}
+
+		// the adjacency of src in a graph or a const graph, after checking that both ends exist
+		template<typename Graph>
+		static auto adjacency_of(Graph& g, N const& src, N const& dst, char const* message)
+		   -> auto& {
+			auto const it_src = g.nodes_.find(src);
+			if (it_src == g.nodes_.end() or not g.nodes_.contains(dst)) {
+				throw std::runtime_error(std::string("Cannot call gdwg::simple_graph<N, E>::")
+				                         + message);
+			}
+			return it_src->second;
+		}
+
+		auto insert(value_type const& edge) -> bool {
+			if constexpr (is_weighted) {
+				return insert_edge(edge.from, edge.to, edge.weight);
+			}
+			else {
+				return insert_edge(edge.from, edge.to);
+			}
+		}
+
+		static constexpr auto insert_edge_error = "insert_edge when either src or dst node does not "
+		                                          "exist";
+
+		// src -> dst -> weight, or src -> set of dst
+		node_map nodes_;
+		std::size_t num_edges_ = 0;
+	};
+
+	// every edge is only a (src, dst) pair
+	template<typename N>
+	using unweighted_graph = simple_graph<N, void>;
+} // namespace gdwg
+
+#endif // GDWG_SIMPLE_GRAPH_HPP
@@ -0,0 +1,338 @@
+#ifndef GDWG_TEMPORAL_GRAPH_HPP
+#define GDWG_TEMPORAL_GRAPH_HPP
+
+#include <algorithm>
+#include <concepts/concepts.hpp>
+#include <cstddef>
+#include <functional>
+#include <gdwg/graph.hpp>
+#include <initializer_list>
+#include <map>
+#include <optional>
+#include <queue>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+namespace gdwg {
+	// a directed weighted graph whose edges are valid during [begin, end) only.
+	//
+	// Edges are kept sorted by (begin, src, dst, weight, end) in blocks of at most block_capacity
+	// edges. Appending in time order only ever touches the last block, and every time window query
+	// is a sequential scan of the blocks that start before the window closes, skipping the blocks
+	// whose edges have all expired before it opens.
+	template<concepts::regular N, concepts::regular E, concepts::regular Time>
+	requires concepts::totally_ordered<N> //
+	   and concepts::totally_ordered<E> //
+	   and concepts::totally_ordered<Time> //
+	   class temporal_graph {
+	public:
+		struct value_type {
+			N from;
+			N to;
+			E weight;
+			Time begin;
+			Time end;
+
+			auto operator==(value_type const&) const -> bool = default;
+		};
+
+		static constexpr auto block_capacity = std::size_t{512};
+
+		temporal_graph() = default;
+
+		temporal_graph(std::initializer_list<N> il)
+		: nodes_(il.begin(), il.end()) {}
+
+		//---------------------------- modifiers -----------------------------------------
+		auto insert_node(N const& value) -> bool {
+			return nodes_.insert(value).second;
+		}
+
+		// O(log(e) + block_capacity), O(log(e)) when appending in time order
+		auto insert_edge(N const& src,
+		                 N const& dst,
+		                 E const& weight,
+		                 Time const& begin,
+		                 Time const& end) -> bool {
+			if (not is_node(src) or not is_node(dst)) {
+				throw std::runtime_error("Cannot call gdwg::temporal_graph<N, E, Time>::insert_edge "
+				                         "when either src or dst node does not exist");
+			}
+			if (not(begin < end)) {
+				throw std::runtime_error("Cannot call gdwg::temporal_graph<N, E, Time>::insert_edge "
+				                         "with an empty validity interval");
+			}
+			auto const edge = value_type{src, dst, weight, begin, end};
+			if (blocks_.empty()) {
+				blocks_.push_back({{edge}, end});
+				++num_edges_;
+				return true;
+			}
+			auto const b = block_of(edge);
+			auto& edges = blocks_[b].edges;
+			auto const it = std::lower_bound(edges.begin(), edges.end(), edge, by_key);
+			if (it != edges.end() and *it == edge) {
+				return false;
+			}
+			edges.insert(it, edge);
+			blocks_[b].max_end = std::max(blocks_[b].max_end, end);
+			++num_edges_;
+			if (edges.size() > block_capacity) {
+				split(b);
+			}
+			return true;
+		}
+
+		auto erase_edge(N const& src,
+		                N const& dst,
+		                E const& weight,
+		                Time const& begin,
+		                Time const& end) -> bool {
+			if (not is_node(src) or not is_node(dst)) {
+				throw std::runtime_error("Cannot call gdwg::temporal_graph<N, E, Time>::erase_edge on "
+				                         "src or dst if they don't exist in the graph");
+			}
+			if (blocks_.empty()) {
+				return false;
+			}
+			auto const edge = value_type{src, dst, weight, begin, end};
+			auto const b = block_of(edge);
+			auto& edges = blocks_[b].edges;
+			auto const it = std::lower_bound(edges.begin(), edges.end(), edge, by_key);
+			if (it == edges.end() or not(*it == edge)) {
+				return false;
+			}
+			edges.erase(it);
+			--num_edges_;
+			if (edges.empty()) {
+				blocks_.erase(blocks_.begin() + static_cast<std::ptrdiff_t>(b));
+			}
+			else {
+				blocks_[b].max_end = max_end_of(edges);
+			}
+			return true;
+		}
+
+		auto clear() noexcept -> void {
+			nodes_.clear();
+			blocks_.clear();
+			num_edges_ = 0;
+		}
+
+		//-------------------------------- Accessors --------------------------------------------
+		[[nodiscard]] auto is_node(N const& value) const -> bool {
+			return nodes_.contains(value);
+		}
+
+		[[nodiscard]] auto nodes() const -> std::vector<N> {
+			return std::vector<N>(nodes_.begin(), nodes_.end());
+		}
+
+		[[nodiscard]] auto num_edges() const noexcept -> std::size_t {
+			return num_edges_;
+		}
+
+		// every edge valid at some time in [t0, t1), sorted by begin time
+		[[nodiscard]] auto edges_between(Time const& t0, Time const& t1) const
+		   -> std::vector<value_type> {
+			auto result = std::vector<value_type>{};
+			scan(t0, t1, [&result](value_type const& edge) { result.push_back(edge); });
+			return result;
+		}
+
+		// the graph made of every node and of the edges valid at time t, instead of keeping one
+		// full copy of the graph per period
+		[[nodiscard]] auto snapshot_at(Time const& t) const -> graph<N, E> {
+			auto result = graph<N, E>(nodes_.begin(), nodes_.end());
+			for (auto const& block : blocks_) {
+				if (t < block.edges.front().begin) {
+					break;
+				}
+				if (not(t < block.max_end)) {
+					continue;
+				}
+				for (auto const& edge : block.edges) {
+					if (t < edge.begin) {
+						break;
+					}
+					if (t < edge.end) {
+						result.insert_edge(edge.from, edge.to, edge.weight);
+					}
+				}
+			}
+			return result;
+		}
+
+		// earliest time dst can be reached leaving src at start. An edge is traversed instantly at
+		// any time of its validity interval and one may wait at any node
+		[[nodiscard]] auto earliest_arrival(N const& src, N const& dst, Time const& start) const
+		   -> std::optional<Time> {
+			check_path_nodes(src, dst, "earliest_arrival");
+			auto const arrival = earliest_arrivals(src, dst, start);
+			auto const it = arrival.find(dst);
+			if (it == arrival.end()) {
+				return std::nullopt;
+			}
+			return it->second.time;
+		}
+
+		// the edges of a time respecting path reaching dst at the earliest arrival time, in the
+		// order they are traversed. std::nullopt if there is no such path
+		[[nodiscard]] auto time_respecting_path(N const& src, N const& dst, Time const& start) const
+		   -> std::optional<std::vector<value_type>> {
+			check_path_nodes(src, dst, "time_respecting_path");
+			auto const arrival = earliest_arrivals(src, dst, start);
+			if (not arrival.contains(dst)) {
+				return std::nullopt;
+			}
+			auto path = std::vector<value_type>{};
+			for (auto it = arrival.find(dst); it->second.via != nullptr;
+			     it = arrival.find(it->second.via->from)) {
+				path.push_back(*it->second.via);
+			}
+			std::reverse(path.begin(), path.end());
+			return path;
+		}
+
+	private:
+		// sorted edges, and the latest end time among them
+		struct edge_block {
+			std::vector<value_type> edges;
+			Time max_end;
+		};
+
+		// arrival time at a node, and the edge it was reached through
+		struct arrival_type {
+			Time time;
+			value_type const* via;
+		};
+
+		static auto key(value_type const& edge) {
+			return std::tie(edge.begin, edge.from, edge.to, edge.weight, edge.end);
+		}
+
+		static auto by_key(value_type const& a, value_type const& b) -> bool {
+			return key(a) < key(b);
+		}
+
+		static auto max_end_of(std::vector<value_type> const& edges) -> Time {
+			auto const it =
+			   std::max_element(edges.begin(), edges.end(), [](auto const& a, auto const& b) {
+				   return a.end < b.end;
+			   });
+			return it->end;
+		}
+
+		// index of the block edge belongs to: the last one starting at or before it
+		auto block_of(value_type const& edge) const -> std::size_t {
+			auto const it = std::upper_bound(blocks_.begin(),
+			                                 blocks_.end(),
+			                                 edge,
+			                                 [](value_type const& e, edge_block const& b) {
+				                                 return by_key(e, b.edges.front());
+			                                 });
+			return it == blocks_.begin() ? 0 : static_cast<std::size_t>(it - blocks_.begin()) - 1;
+		}
+
+		auto split(std::size_t b) -> void {
+			auto& edges = blocks_[b].edges;
+			auto const middle = edges.begin() + static_cast<std::ptrdiff_t>(edges.size() / 2);
+			auto upper = std::vector<value_type>(middle, edges.end());
+			edges.erase(middle, edges.end());
+			blocks_[b].max_end = max_end_of(edges);
+			auto const upper_end = max_end_of(upper);
+			blocks_.insert(blocks_.begin() + static_cast<std::ptrdiff_t>(b) + 1,
+			               edge_block{std::move(upper), upper_end});
+		}
+
+		// calls f on every edge valid at some time in [t0, t1), by increasing begin time
+		template<typename F>
+		auto scan(Time const& t0, Time const& t1, F f) const -> void {
+			if (not(t0 < t1)) {
+				return;
+			}
+			for (auto const& block : blocks_) {
+				if (not(block.edges.front().begin < t1)) {
+					return;
+				}
+				if (not(t0 < block.max_end)) {
+					continue;
+				}
+				for (auto const& edge : block.edges) {
+					if (not(edge.begin < t1)) {
+						return;
+					}
+					if (t0 < edge.end) {
+						f(edge);
+					}
+				}
+			}
+		}
+
+		auto check_path_nodes(N const& src, N const& dst, char const* caller) const -> void {
+			if (not is_node(src) or not is_node(dst)) {
+				throw std::runtime_error(std::string("Cannot call gdwg::temporal_graph<N, E, Time>::")
+				                         + caller + " if src or dst node don't exist in the graph");
+			}
+		}
+
+		// Dijkstra on arrival times over the edges still valid after start, stopping at dst
+		auto earliest_arrivals(N const& src, N const& dst, Time const& start) const
+		   -> std::map<N, arrival_type> {
+			auto out_edges = std::map<N, std::vector<value_type const*>>{};
+			for (auto const& block : blocks_) {
+				if (not(start < block.max_end)) {
+					continue;
+				}
+				for (auto const& edge : block.edges) {
+					if (start < edge.end) {
+						out_edges[edge.from].push_back(&edge);
+					}
+				}
+			}
+
+			auto arrival = std::map<N, arrival_type>{{src, {start, nullptr}}};
+			auto settled = std::set<N>{};
+			using entry = std::pair<Time, N>;
+			auto queue = std::priority_queue<entry, std::vector<entry>, std::greater<>>{};
+			queue.emplace(start, src);
+			while (not queue.empty()) {
+				auto const [time, node] = queue.top();
+				queue.pop();
+				if (node == dst) {
+					break;
+				}
+				if (not settled.insert(node).second) {
+					continue;
+				}
+				auto const it = out_edges.find(node);
+				if (it == out_edges.end()) {
+					continue;
+				}
+				for (auto const* edge : it->second) {
+					auto const departure = std::max(time, edge->begin);
+					if (not(departure < edge->end)) {
+						continue;
+					}
+					auto const [to, inserted] =
+					   arrival.try_emplace(edge->to, arrival_type{departure, edge});
+					if (inserted or departure < to->second.time) {
+						to->second = {departure, edge};
+						queue.emplace(departure, edge->to);
+					}
+				}
+			}
+			return arrival;
+		}
+
+		std::set<N> nodes_;
+		std::vector<edge_block> blocks_;
+		std::size_t num_edges_ = 0;
+	};
+} // namespace gdwg
+
+#endif // GDWG_TEMPORAL_GRAPH_HPP
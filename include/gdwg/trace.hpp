@@ -0,0 +1,209 @@
+#ifndef GDWG_TRACE_HPP
+#define GDWG_TRACE_HPP
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <fmt/format.h>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// spans of the public members of gdwg::graph and of their internal phases, recorded when
+// GDWG_ENABLE_TRACE is defined and exported in the Chrome trace event format, which
+// chrome://tracing and https://ui.perfetto.dev open directly.
+//
+// Every thread appends to its own ring buffer of the last buffer_capacity spans, so a long run
+// keeps its most recent history in bounded memory. Span names must be string literals: recording
+// a span copies a pointer and two timestamps, nothing is allocated.
+namespace gdwg::trace {
+	inline constexpr auto buffer_capacity = std::size_t{1} << 16U;
+
+	struct event {
+		char const* name;
+		std::uint32_t thread;
+		std::int64_t begin_ns;
+		std::int64_t duration_ns;
+	};
+
+	namespace detail {
+		inline auto now_ns() noexcept -> std::int64_t {
+			static auto const epoch = std::chrono::steady_clock::now();
+			return std::chrono::duration_cast<std::chrono::nanoseconds>(
+			          std::chrono::steady_clock::now() - epoch)
+			   .count();
+		}
+
+		// the spans of one thread. The lock is only ever contended by an export
+		class buffer {
+		public:
+			explicit buffer(std::uint32_t thread)
+			: thread_{thread} {}
+
+			auto push(char const* name, std::int64_t begin, std::int64_t end) -> void {
+				auto const lock = std::lock_guard(mutex_);
+				auto const e = event{name, thread_, begin, end - begin};
+				if (events_.size() < buffer_capacity) {
+					events_.push_back(e);
+				}
+				else {
+					events_[next_] = e;
+					next_ = (next_ + 1) % buffer_capacity;
+				}
+			}
+
+			// oldest first
+			auto append_to(std::vector<event>& result) const -> void {
+				auto const lock = std::lock_guard(mutex_);
+				auto const oldest = events_.begin() + static_cast<std::ptrdiff_t>(next_);
+				result.insert(result.end(), oldest, events_.end());
+				result.insert(result.end(), events_.begin(), oldest);
+			}
+
+			auto clear() -> void {
+				auto const lock = std::lock_guard(mutex_);
+				events_.clear();
+				next_ = 0;
+			}
+
+		private:
+			mutable std::mutex mutex_;
+			std::uint32_t thread_;
+			std::vector<event> events_;
+			std::size_t next_ = 0;
+		};
+
+		struct registry {
+			std::mutex mutex;
+			// kept after their thread exits: its spans stay in the exports
+			std::vector<std::shared_ptr<buffer>> buffers;
+		};
+
+		inline auto global() -> registry& {
+			static auto instance = registry{};
+			return instance;
+		}
+
+		inline auto local() -> buffer& {
+			thread_local auto const instance = [] {
+				auto& r = global();
+				auto const lock = std::lock_guard(r.mutex);
+				auto const thread = static_cast<std::uint32_t>(r.buffers.size() + 1);
+				auto result = std::make_shared<buffer>(thread);
+				r.buffers.push_back(result);
+				return result;
+			}();
+			return *instance;
+		}
+
+		inline auto enabled = std::atomic<bool>{true};
+	} // namespace detail
+
+	inline auto set_enabled(bool on) noexcept -> void {
+		detail::enabled.store(on, std::memory_order_relaxed);
+	}
+	[[nodiscard]] inline auto enabled() noexcept -> bool {
+		return detail::enabled.load(std::memory_order_relaxed);
+	}
+
+	// records [construction, destruction) under name
+	class span {
+	public:
+		explicit span(char const* name) noexcept
+		: name_{enabled() ? name : nullptr}
+		, begin_{name_ == nullptr ? 0 : detail::now_ns()} {}
+
+		span(span const&) = delete;
+		auto operator=(span const&) -> span& = delete;
+
+		~span() {
+			if (name_ != nullptr) {
+				detail::local().push(name_, begin_, detail::now_ns());
+			}
+		}
+
+	private:
+		char const* name_;
+		std::int64_t begin_;
+	};
+
+	// consecutive phases of one function: next() closes the current phase and opens another one
+	class phase {
+	public:
+		explicit phase(char const* name) noexcept
+		: name_{enabled() ? name : nullptr}
+		, begin_{name_ == nullptr ? 0 : detail::now_ns()} {}
+
+		phase(phase const&) = delete;
+		auto operator=(phase const&) -> phase& = delete;
+
+		~phase() {
+			close(detail::now_ns());
+		}
+
+		auto next(char const* name) -> void {
+			auto const now = detail::now_ns();
+			close(now);
+			name_ = enabled() ? name : nullptr;
+			begin_ = now;
+		}
+
+	private:
+		auto close(std::int64_t end) -> void {
+			if (name_ != nullptr) {
+				detail::local().push(name_, begin_, end);
+			}
+		}
+
+		char const* name_;
+		std::int64_t begin_;
+	};
+
+	// the spans of every thread, oldest first within a thread
+	[[nodiscard]] inline auto events() -> std::vector<event> {
+		auto result = std::vector<event>{};
+		auto& r = detail::global();
+		auto const lock = std::lock_guard(r.mutex);
+		for (auto const& buffer : r.buffers) {
+			buffer->append_to(result);
+		}
+		return result;
+	}
+
+	inline auto clear() -> void {
+		auto& r = detail::global();
+		auto const lock = std::lock_guard(r.mutex);
+		for (auto const& buffer : r.buffers) {
+			buffer->clear();
+		}
+	}
+
+	// {"traceEvents": [complete ("X") events]}, timestamps in microseconds
+	[[nodiscard]] inline auto to_chrome_json(std::vector<event> const& spans) -> std::string {
+		auto result = std::string(R"({"displayTimeUnit":"ns","traceEvents":[)");
+		auto first = true;
+		for (auto const& e : spans) {
+			if (not first) {
+				result += ",";
+			}
+			first = false;
+			// span names are plain literals ==> not escaped
+			result += fmt::format(R"({{"name":"{}","ph":"X","pid":1,"tid":{},)"
+			                      R"("ts":{:.3f},"dur":{:.3f}}})",
+			                      e.name,
+			                      e.thread,
+			                      static_cast<double>(e.begin_ns) / 1000.0,
+			                      static_cast<double>(e.duration_ns) / 1000.0);
+		}
+		return result + "]}";
+	}
+
+	[[nodiscard]] inline auto to_chrome_json() -> std::string {
+		return to_chrome_json(events());
+	}
+} // namespace gdwg::trace
+
+#endif // GDWG_TRACE_HPP
@@ -0,0 +1,107 @@
+#ifndef GDWG_TRANSITIVE_CLOSURE_HPP
+#define GDWG_TRANSITIVE_CLOSURE_HPP
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <gdwg/detail/csr.hpp>
+#include <gdwg/detail/parallel.hpp>
+#include <gdwg/graph.hpp>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace gdwg {
+	// reachability between every pair of nodes of a DAG, as one row of n bits per node:
+	// reaches(a, b) is a lookup of the ids of a and b and a single bit test.
+	//
+	// Rows are computed from the sinks up: the row of a node is its own bit OR the rows of its
+	// successors, 64 nodes per word (loops the compiler vectorises). The nodes of one height only
+	// read rows of lower heights, so each height is computed in parallel.
+	// Memory is n^2 / 8 bytes: about 1.25 GB for 100k nodes.
+	// The closure is a snapshot: later changes of the graph are not reflected
+	template<typename N>
+	class transitive_closure {
+	public:
+		// threads = 0 ==> one per core
+		template<typename E>
+		explicit transitive_closure(graph<N, E> const& g, std::size_t threads = 0) {
+			auto const c = detail::to_csr(g);
+			auto const order = detail::topological_order(c);
+			if (not order) {
+				throw std::runtime_error("Cannot compute gdwg::transitive_closure of a graph with a "
+				                         "cycle");
+			}
+			nodes_ = c.nodes;
+			auto const n = c.size();
+			words_ = (n + 63) / 64;
+			rows_.assign(n * words_, 0);
+
+			auto const heights = detail::height_levels(c, *order);
+			// below a few thousand nodes, starting threads costs more than it saves
+			auto const workers = n < 4096 ? std::size_t{1} : detail::thread_count(threads, n / 64);
+			detail::for_each_level(heights, workers, [this, &c](std::size_t u) {
+				auto* const row = row_of(u);
+				row[u / 64] |= std::uint64_t{1} << (u % 64);
+				for (auto e = c.offsets[u]; e < c.offsets[u + 1]; ++e) {
+					auto const* const other = row_of(c.targets[e]);
+					for (auto w = std::size_t{0}; w < words_; ++w) {
+						row[w] |= other[w];
+					}
+				}
+			});
+		}
+
+		// whether there is a path from src to dst. Every node reaches itself
+		[[nodiscard]] auto reaches(N const& src, N const& dst) const -> bool {
+			auto const a = id_of(src, "reaches");
+			auto const b = id_of(dst, "reaches");
+			return ((row_of(a)[b / 64] >> (b % 64)) & 1U) != 0;
+		}
+
+		// every node reachable from src, in ascending order
+		[[nodiscard]] auto reachable_from(N const& src) const -> std::vector<N> {
+			auto const* const row = row_of(id_of(src, "reachable_from"));
+			auto result = std::vector<N>{};
+			for (auto w = std::size_t{0}; w < words_; ++w) {
+				for (auto bits = row[w]; bits != 0; bits &= bits - 1) {
+					result.push_back(nodes_[w * 64 + static_cast<std::size_t>(std::countr_zero(bits))]);
+				}
+			}
+			return result;
+		}
+
+		[[nodiscard]] auto nodes() const -> std::vector<N> const& {
+			return nodes_;
+		}
+
+	private:
+		auto id_of(N const& value, char const* caller) const -> std::size_t {
+			auto const it = std::lower_bound(nodes_.begin(), nodes_.end(), value);
+			if (it == nodes_.end() or not(*it == value)) {
+				throw std::runtime_error(std::string("Cannot call gdwg::transitive_closure<N>::")
+				                         + caller + " on a node that doesn't exist in the graph");
+			}
+			return static_cast<std::size_t>(it - nodes_.begin());
+		}
+
+		auto row_of(std::size_t u) -> std::uint64_t* {
+			return rows_.data() + u * words_;
+		}
+		auto row_of(std::size_t u) const -> std::uint64_t const* {
+			return rows_.data() + u * words_;
+		}
+
+		std::vector<N> nodes_;
+		std::size_t words_ = 0;
+		std::vector<std::uint64_t> rows_;
+	};
+
+	template<typename N, typename E>
+	transitive_closure(graph<N, E> const&) -> transitive_closure<N>;
+	template<typename N, typename E>
+	transitive_closure(graph<N, E> const&, std::size_t) -> transitive_closure<N>;
+} // namespace gdwg
+
+#endif // GDWG_TRANSITIVE_CLOSURE_HPP
@@ -0,0 +1,431 @@
+#ifndef GDWG_UNDIRECTED_GRAPH_HPP
+#define GDWG_UNDIRECTED_GRAPH_HPP
+
+#include <algorithm>
+#include <concepts/concepts.hpp>
+#include <cstddef>
+#include <fmt/format.h>
+#include <initializer_list>
+#include <iterator>
+#include <map>
+#include <ostream>
+#include <range/v3/algorithm.hpp>
+#include <range/v3/iterator.hpp>
+#include <range/v3/utility.hpp>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+namespace gdwg {
+	// an undirected weighted graph: the edge {a, b, w} joins a and b both ways.
+	//
+	// Every edge is stored once, under its smaller end, as (min(a, b), max(a, b), w). Each node also
+	// keeps its smaller neighbours, without weights, so that connections() and iteration find the
+	// edges stored under the other end in O(log(n)) instead of a scan. The accessors and the
+	// iterator present the symmetric view: is_connected(a, b) == is_connected(b, a), weights(a, b)
+	// == weights(b, a), and iteration visits {a, b, w} as (a, b, w) and as (b, a, w), sorted by
+	// (from, to, weight) like graph<N, E>. A self loop is visited once. num_edges() counts the
+	// stored edges, each once
+	template<concepts::regular N, concepts::regular E>
+	requires concepts::totally_ordered<N> //
+	   and concepts::totally_ordered<E> //
+	   class undirected_graph {
+	private:
+		using weight_set = std::set<E>;
+		struct adjacency {
+			// the neighbours >= the node, itself for a self loop, and the weights of the edges
+			std::map<N, weight_set> upper;
+			// the neighbours < the node: the weights are in their own upper
+			std::set<N> lower;
+
+			auto operator==(adjacency const&) const -> bool = default;
+		};
+		using node_map = std::map<N, adjacency>;
+
+	public:
+		class iterator;
+
+		struct value_type {
+			N from;
+			N to;
+			E weight;
+		};
+
+		undirected_graph() noexcept = default;
+
+		undirected_graph(std::initializer_list<N> il)
+		: undirected_graph(il.begin(), il.end()) {}
+
+		template<ranges::forward_iterator I, ranges::sentinel_for<I> S>
+		requires ranges::indirectly_copyable<I, N*> undirected_graph(I first, S last) {
+			ranges::for_each(first, last, [this](N const& n) { insert_node(n); });
+		}
+
+		template<ranges::forward_iterator I, ranges::sentinel_for<I> S>
+		requires ranges::indirectly_copyable<I, value_type*> undirected_graph(I first, S last) {
+			ranges::for_each(first, last, [this](value_type const& v) {
+				insert_node(v.from);
+				insert_node(v.to);
+				insert_edge(v.from, v.to, v.weight);
+			});
+		}
+
+		//---------------------------- modifiers -----------------------------------------
+		auto insert_node(N const& value) -> bool {
+			return nodes_.try_emplace(value).second;
+		}
+
+		// false if {a, b, weight} or {b, a, weight} already exists. O(log(n) + log(d))
+		auto insert_edge(N const& a, N const& b, E const& weight) -> bool {
+			auto const it_a = nodes_.find(a);
+			auto const it_b = nodes_.find(b);
+			if (it_a == nodes_.end() or it_b == nodes_.end()) {
+				throw std::runtime_error("Cannot call gdwg::undirected_graph<N, E>::insert_edge when "
+				                         "either src or dst node does not exist");
+			}
+			auto const [lo, hi] = b < a ? std::pair(it_b, it_a) : std::pair(it_a, it_b);
+			if (not lo->second.upper[hi->first].insert(weight).second) {
+				return false;
+			}
+			if (lo != hi) {
+				hi->second.lower.insert(lo->first);
+			}
+			++num_edges_;
+			return true;
+		}
+
+		auto replace_node(N const& old_data, N const& new_data) -> bool {
+			if (not is_node(old_data)) {
+				throw std::runtime_error("Cannot call gdwg::undirected_graph<N, E>::replace_node on a "
+				                         "node that doesn't exist");
+			}
+			if (is_node(new_data)) {
+				return false;
+			}
+			insert_node(new_data);
+			merge_replace_node(old_data, new_data);
+			return true;
+		}
+
+		// O(d log(n)): only the edges of old_data are visited
+		auto merge_replace_node(N const& old_data, N const& new_data) -> void {
+			if (not is_node(old_data) or not is_node(new_data)) {
+				throw std::runtime_error("Cannot call gdwg::undirected_graph<N, E>::merge_replace_node "
+				                         "on old or new data if they don't exist in the graph");
+			}
+			if (old_data == new_data) {
+				return;
+			}
+			auto moved = std::vector<value_type>{};
+			for (auto it = find_from(old_data); it != end(); ++it) {
+				auto const& [from, to, weight] = *it;
+				if (from != old_data) {
+					break;
+				}
+				moved.push_back({new_data, to == old_data ? new_data : to, weight});
+			}
+			erase_node(old_data);
+			// duplicates are merged by the weight sets
+			for (auto const& edge : moved) {
+				insert_edge(edge.from, edge.to, edge.weight);
+			}
+		}
+
+		// O(d log(n))
+		auto erase_node(N const& value) -> bool {
+			auto const it = nodes_.find(value);
+			if (it == nodes_.end()) {
+				return false;
+			}
+			for (auto const& [neighbour, weights] : it->second.upper) {
+				num_edges_ -= weights.size();
+				if (neighbour != value) {
+					nodes_.at(neighbour).lower.erase(value);
+				}
+			}
+			for (auto const& neighbour : it->second.lower) {
+				auto& upper = nodes_.at(neighbour).upper;
+				auto const it_weights = upper.find(value);
+				num_edges_ -= it_weights->second.size();
+				upper.erase(it_weights);
+			}
+			nodes_.erase(it);
+			return true;
+		}
+
+		// erases {a, b, weight}, whichever order it was inserted in
+		auto erase_edge(N const& a, N const& b, E const& weight) -> bool {
+			auto const it_a = nodes_.find(a);
+			auto const it_b = nodes_.find(b);
+			if (it_a == nodes_.end() or it_b == nodes_.end()) {
+				throw std::runtime_error("Cannot call gdwg::undirected_graph<N, E>::erase_edge on src "
+				                         "or dst if they don't exist in the graph");
+			}
+			auto const [lo, hi] = b < a ? std::pair(it_b, it_a) : std::pair(it_a, it_b);
+			auto& upper = lo->second.upper;
+			auto const it_weights = upper.find(hi->first);
+			if (it_weights == upper.end() or it_weights->second.erase(weight) == 0) {
+				return false;
+			}
+			--num_edges_;
+			// never keep an empty weight set: is_connected() relies on it
+			if (it_weights->second.empty()) {
+				upper.erase(it_weights);
+				hi->second.lower.erase(lo->first);
+			}
+			return true;
+		}
+
+		auto clear() noexcept -> void {
+			nodes_.clear();
+			num_edges_ = 0;
+		}
+
+		//-------------------------------- Accessors --------------------------------------------
+		[[nodiscard]] auto is_node(N const& value) const -> bool {
+			return nodes_.contains(value);
+		}
+
+		[[nodiscard]] auto empty() const -> bool {
+			return nodes_.empty();
+		}
+
+		[[nodiscard]] auto is_connected(N const& src, N const& dst) const -> bool {
+			return weights_of(src, dst, "is_connected") != nullptr;
+		}
+
+		[[nodiscard]] auto nodes() const -> std::vector<N> {
+			auto result = std::vector<N>{};
+			result.reserve(nodes_.size());
+			for (auto const& [node, adjacent] : nodes_) {
+				result.push_back(node);
+			}
+			return result;
+		}
+
+		// in ascending order
+		[[nodiscard]] auto weights(N const& src, N const& dst) const -> std::vector<E> {
+			auto const* weights = weights_of(src, dst, "weights");
+			if (weights == nullptr) {
+				return {};
+			}
+			return std::vector<E>(weights->begin(), weights->end());
+		}
+
+		// the iterator at (src, dst, weight), end() if there is no such edge
+		[[nodiscard]] auto find(N const& src, N const& dst, E const& weight) const -> iterator {
+			auto const it_src = nodes_.find(src);
+			if (it_src == nodes_.end() or not is_node(dst)) {
+				return end();
+			}
+			auto const& adjacent = it_src->second;
+			if (dst < src) {
+				auto const lower = adjacent.lower.find(dst);
+				if (lower == adjacent.lower.end()) {
+					return end();
+				}
+				auto const& weights = nodes_.at(dst).upper.at(src);
+				auto const it_weight = weights.find(weight);
+				if (it_weight == weights.end()) {
+					return end();
+				}
+				return iterator(&nodes_, it_src, lower, adjacent.upper.begin(), &weights, it_weight);
+			}
+			auto const upper = adjacent.upper.find(dst);
+			if (upper == adjacent.upper.end()) {
+				return end();
+			}
+			auto const it_weight = upper->second.find(weight);
+			if (it_weight == upper->second.end()) {
+				return end();
+			}
+			return iterator(&nodes_, it_src, adjacent.lower.end(), upper, &upper->second, it_weight);
+		}
+
+		// every neighbour of src, in ascending order
+		[[nodiscard]] auto connections(N const& src) const -> std::vector<N> {
+			auto const it_src = nodes_.find(src);
+			if (it_src == nodes_.end()) {
+				throw std::runtime_error("Cannot call gdwg::undirected_graph<N, E>::connections if src "
+				                         "doesn't exist in the graph");
+			}
+			// the lower neighbours all come before the upper ones ==> already sorted
+			auto const& adjacent = it_src->second;
+			auto result = std::vector<N>(adjacent.lower.begin(), adjacent.lower.end());
+			result.reserve(adjacent.lower.size() + adjacent.upper.size());
+			for (auto const& [neighbour, weights] : adjacent.upper) {
+				result.push_back(neighbour);
+			}
+			return result;
+		}
+
+		// every edge counted once
+		[[nodiscard]] auto num_edges() const noexcept -> std::size_t {
+			return num_edges_;
+		}
+
+		//--------------------------------- range access ------------------------------------
+		[[nodiscard]] auto begin() const -> iterator {
+			return iterator(&nodes_, nodes_.begin());
+		}
+
+		[[nodiscard]] auto end() const -> iterator {
+			return iterator(&nodes_, nodes_.end());
+		}
+
+		// ------------------------------ comparisons --------------------------------------
+		[[nodiscard]] auto operator==(undirected_graph const& other) const -> bool {
+			return num_edges_ == other.num_edges_ and nodes_ == other.nodes_;
+		}
+
+		// ------------------------------ extractor ----------------------------------------
+		// the format of graph<N, E>, every edge listed under both of its ends
+		friend auto operator<<(std::ostream& os, undirected_graph const& g) -> std::ostream& {
+			auto it = g.begin();
+			for (auto const& [node, adjacent] : g.nodes_) {
+				os << node << " (\n";
+				for (; it != g.end(); ++it) {
+					auto const& [from, to, weight] = *it;
+					if (from != node) {
+						break;
+					}
+					os << fmt::format("  {} | {}\n", to, weight);
+				}
+				os << ")\n";
+			}
+			return os;
+		}
+
+		// ------------------------------ Iterator -----------------------------------------
+		// forward iterator over the symmetric view: node by node, then through the lower
+		// neighbours, then the upper ones, weight by weight
+		class iterator {
+		private:
+			using outer_iter = typename node_map::const_iterator;
+			using lower_iter = typename std::set<N>::const_iterator;
+			using upper_iter = typename std::map<N, weight_set>::const_iterator;
+			using inner_iter = typename weight_set::const_iterator;
+
+		public:
+			using value_type = ranges::common_tuple<N, N, E>;
+			using reference = ranges::common_tuple<N const&, N const&, E const&>;
+			using difference_type = std::ptrdiff_t;
+			using iterator_category = std::forward_iterator_tag;
+
+			iterator() = default;
+
+			auto operator*() const -> reference {
+				auto const& to = lower_ != outer_->second.lower.end() ? *lower_ : upper_->first;
+				return reference{outer_->first, to, *inner_};
+			}
+
+			auto operator++() -> iterator& {
+				++inner_;
+				if (inner_ != weights_->end()) {
+					return *this;
+				}
+				if (lower_ != outer_->second.lower.end()) {
+					++lower_;
+				}
+				else {
+					++upper_;
+				}
+				skip_empty();
+				return *this;
+			}
+			auto operator++(int) -> iterator {
+				auto temp = *this;
+				++*this;
+				return temp;
+			}
+
+			auto operator==(iterator const& other) const -> bool {
+				if (nodes_ != other.nodes_ or outer_ != other.outer_) {
+					return false;
+				}
+				return nodes_ == nullptr or outer_ == nodes_->end()
+				       or (lower_ == other.lower_ and upper_ == other.upper_
+				           and inner_ == other.inner_);
+			}
+
+		private:
+			friend class undirected_graph;
+
+			// first edge at or after outer
+			iterator(node_map const* nodes, outer_iter outer)
+			: nodes_{nodes}
+			, outer_{outer} {
+				if (outer_ != nodes_->end()) {
+					lower_ = outer_->second.lower.begin();
+					upper_ = outer_->second.upper.begin();
+					skip_empty();
+				}
+			}
+
+			iterator(node_map const* nodes,
+			         outer_iter outer,
+			         lower_iter lower,
+			         upper_iter upper,
+			         weight_set const* weights,
+			         inner_iter inner)
+			: nodes_{nodes}
+			, outer_{outer}
+			, lower_{lower}
+			, upper_{upper}
+			, weights_{weights}
+			, inner_{inner} {}
+
+			// weight sets are never empty ==> only nodes without any neighbour are skipped
+			auto skip_empty() -> void {
+				while (lower_ == outer_->second.lower.end() and upper_ == outer_->second.upper.end()) {
+					++outer_;
+					if (outer_ == nodes_->end()) {
+						return;
+					}
+					lower_ = outer_->second.lower.begin();
+					upper_ = outer_->second.upper.begin();
+				}
+				// a lower neighbour stores the edge under its own upper. O(log(n))
+				weights_ = lower_ != outer_->second.lower.end()
+				              ? &nodes_->find(*lower_)->second.upper.find(outer_->first)->second
+				              : &upper_->second;
+				inner_ = weights_->begin();
+			}
+
+			node_map const* nodes_ = nullptr;
+			outer_iter outer_;
+			// lower_ at its end ==> going through the upper neighbours
+			lower_iter lower_;
+			upper_iter upper_;
+			weight_set const* weights_ = nullptr;
+			inner_iter inner_;
+		};
+
+	private:
+		// the weights of {src, dst}, stored under the smaller end. nullptr if they aren't adjacent
+		auto weights_of(N const& src, N const& dst, char const* caller) const -> weight_set const* {
+			auto const it_src = nodes_.find(src);
+			auto const it_dst = nodes_.find(dst);
+			if (it_src == nodes_.end() or it_dst == nodes_.end()) {
+				throw std::runtime_error(std::string("Cannot call gdwg::undirected_graph<N, E>::")
+				                         + caller + " if src or dst node don't exist in the graph");
+			}
+			auto const& [lo, hi] = dst < src ? std::tie(*it_dst, *it_src) : std::tie(*it_src, *it_dst);
+			auto const it = lo.second.upper.find(hi.first);
+			return it == lo.second.upper.end() ? nullptr : &it->second;
+		}
+
+		// the first edge of the symmetric view leaving value, end() if there is none
+		auto find_from(N const& value) const -> iterator {
+			return iterator(&nodes_, nodes_.find(value));
+		}
+
+		node_map nodes_;
+		std::size_t num_edges_ = 0;
+	};
+} // namespace gdwg
+
+#endif // GDWG_UNDIRECTED_GRAPH_HPP
@@ -0,0 +1,354 @@
+#ifndef GDWG_UNORDERED_GRAPH_HPP
+#define GDWG_UNORDERED_GRAPH_HPP
+
+#include <absl/container/flat_hash_map.h>
+#include <absl/container/flat_hash_set.h>
+#include <absl/hash/hash.h>
+#include <concepts/concepts.hpp>
+#include <cstddef>
+#include <initializer_list>
+#include <iterator>
+#include <range/v3/algorithm.hpp>
+#include <range/v3/iterator.hpp>
+#include <range/v3/utility.hpp>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace gdwg {
+	template<typename T>
+	concept hashable = concepts::regular<T> and requires(T const& value) {
+		{ absl::Hash<T>{}(value) } -> std::convertible_to<std::size_t>;
+	};
+
+	// same modifiers and accessors as gdwg::graph, for workloads that never look at the order:
+	// N and E only have to be hashable, every container is an open addressing hash table
+	// (absl::flat_hash_map / flat_hash_set) and all point queries are O(1) on average.
+	// nodes(), connections(), weights() and the iteration order are unspecified
+	template<hashable N, hashable E>
+	class unordered_graph {
+	private:
+		using weight_set = absl::flat_hash_set<E>;
+		using adjacency = absl::flat_hash_map<N, weight_set>;
+		using node_map = absl::flat_hash_map<N, adjacency>;
+
+	public:
+		class iterator;
+
+		struct value_type {
+			N from;
+			N to;
+			E weight;
+		};
+
+		unordered_graph() noexcept = default;
+
+		unordered_graph(std::initializer_list<N> il)
+		: unordered_graph(il.begin(), il.end()) {}
+
+		template<ranges::forward_iterator I, ranges::sentinel_for<I> S>
+		requires ranges::indirectly_copyable<I, N*> unordered_graph(I first, S last) {
+			ranges::for_each(first, last, [this](N const& n) { insert_node(n); });
+		}
+
+		template<ranges::forward_iterator I, ranges::sentinel_for<I> S>
+		requires ranges::indirectly_copyable<I, value_type*> unordered_graph(I first, S last) {
+			ranges::for_each(first, last, [this](value_type const& v) {
+				insert_node(v.from);
+				insert_node(v.to);
+				insert_edge(v.from, v.to, v.weight);
+			});
+		}
+
+		//---------------------------- modifiers -----------------------------------------
+		auto insert_node(N const& value) -> bool {
+			if (not out_.try_emplace(value).second) {
+				return false;
+			}
+			in_.try_emplace(value);
+			return true;
+		}
+
+		auto insert_edge(N const& src, N const& dst, E const& weight) -> bool {
+			auto const it_src = out_.find(src);
+			if (it_src == out_.end() or not out_.contains(dst)) {
+				throw std::runtime_error("Cannot call gdwg::unordered_graph<N, E>::insert_edge when "
+				                         "either src or dst node does not exist");
+			}
+			if (not it_src->second[dst].insert(weight).second) {
+				return false;
+			}
+			in_[dst].insert(src);
+			++num_edges_;
+			return true;
+		}
+
+		auto replace_node(N const& old_data, N const& new_data) -> bool {
+			if (not is_node(old_data)) {
+				throw std::runtime_error("Cannot call gdwg::unordered_graph<N, E>::replace_node on a "
+				                         "node that doesn't exist");
+			}
+			if (is_node(new_data)) {
+				return false;
+			}
+			insert_node(new_data);
+			merge_replace_node(old_data, new_data);
+			return true;
+		}
+
+		// the in-neighbour index makes this O(degree of old_data) instead of a scan of every edge
+		auto merge_replace_node(N const& old_data, N const& new_data) -> void {
+			if (not is_node(old_data) or not is_node(new_data)) {
+				throw std::runtime_error("Cannot call gdwg::unordered_graph<N, E>::merge_replace_node "
+				                         "on old or new data if they don't exist in the graph");
+			}
+			if (old_data == new_data) {
+				return;
+			}
+			auto moved = std::vector<value_type>{};
+			for (auto const& [dst, weights] : out_.at(old_data)) {
+				auto const& to = dst == old_data ? new_data : dst;
+				for (auto const& weight : weights) {
+					moved.push_back({new_data, to, weight});
+				}
+			}
+			for (auto const& src : in_.at(old_data)) {
+				if (src == old_data) {
+					continue; // self loop, already moved with the outgoing edges
+				}
+				for (auto const& weight : out_.at(src).at(old_data)) {
+					moved.push_back({src, new_data, weight});
+				}
+			}
+			erase_node(old_data);
+			// duplicates are merged by the weight sets
+			for (auto const& edge : moved) {
+				insert_edge(edge.from, edge.to, edge.weight);
+			}
+		}
+
+		auto erase_node(N const& value) -> bool {
+			auto const it_out = out_.find(value);
+			if (it_out == out_.end()) {
+				return false;
+			}
+			for (auto const& [dst, weights] : it_out->second) {
+				num_edges_ -= weights.size();
+				if (dst != value) {
+					in_.at(dst).erase(value);
+				}
+			}
+			out_.erase(it_out);
+			auto const it_in = in_.find(value);
+			for (auto const& src : it_in->second) {
+				if (src != value) {
+					auto& adjacent = out_.at(src);
+					num_edges_ -= adjacent.at(value).size();
+					adjacent.erase(value);
+				}
+			}
+			in_.erase(it_in);
+			return true;
+		}
+
+		auto erase_edge(N const& src, N const& dst, E const& weight) -> bool {
+			auto const it_src = out_.find(src);
+			if (it_src == out_.end() or not out_.contains(dst)) {
+				throw std::runtime_error("Cannot call gdwg::unordered_graph<N, E>::erase_edge on src "
+				                         "or dst if they don't exist in the graph");
+			}
+			auto const it_dst = it_src->second.find(dst);
+			if (it_dst == it_src->second.end() or not it_dst->second.erase(weight)) {
+				return false;
+			}
+			--num_edges_;
+			// never keep an empty weight set: is_connected() relies on it
+			if (it_dst->second.empty()) {
+				it_src->second.erase(it_dst);
+				in_.at(dst).erase(src);
+			}
+			return true;
+		}
+
+		auto clear() noexcept -> void {
+			out_.clear();
+			in_.clear();
+			num_edges_ = 0;
+		}
+
+		//-------------------------------- Accessors --------------------------------------------
+		[[nodiscard]] auto is_node(N const& value) const -> bool {
+			return out_.contains(value);
+		}
+
+		[[nodiscard]] auto empty() const -> bool {
+			return out_.empty();
+		}
+
+		[[nodiscard]] auto is_connected(N const& src, N const& dst) const -> bool {
+			auto const it_src = out_.find(src);
+			if (it_src == out_.end() or not out_.contains(dst)) {
+				throw std::runtime_error("Cannot call gdwg::unordered_graph<N, E>::is_connected if src "
+				                         "or dst node don't exist in the graph");
+			}
+			return it_src->second.contains(dst);
+		}
+
+		[[nodiscard]] auto nodes() const -> std::vector<N> {
+			auto result = std::vector<N>{};
+			result.reserve(out_.size());
+			for (auto const& [node, adjacent] : out_) {
+				result.push_back(node);
+			}
+			return result;
+		}
+
+		[[nodiscard]] auto weights(N const& src, N const& dst) const -> std::vector<E> {
+			auto const it_src = out_.find(src);
+			if (it_src == out_.end() or not out_.contains(dst)) {
+				throw std::runtime_error("Cannot call gdwg::unordered_graph<N, E>::weights if src or "
+				                         "dst node don't exist in the graph");
+			}
+			auto const it_dst = it_src->second.find(dst);
+			if (it_dst == it_src->second.end()) {
+				return {};
+			}
+			return std::vector<E>(it_dst->second.begin(), it_dst->second.end());
+		}
+
+		[[nodiscard]] auto find(N const& src, N const& dst, E const& weight) const -> iterator {
+			auto const it_src = out_.find(src);
+			if (it_src == out_.end()) {
+				return end();
+			}
+			auto const it_dst = it_src->second.find(dst);
+			if (it_dst == it_src->second.end()) {
+				return end();
+			}
+			auto const it_weight = it_dst->second.find(weight);
+			if (it_weight == it_dst->second.end()) {
+				return end();
+			}
+			return iterator(it_src, out_.end(), it_dst, it_weight);
+		}
+
+		[[nodiscard]] auto connections(N const& src) const -> std::vector<N> {
+			auto const it_src = out_.find(src);
+			if (it_src == out_.end()) {
+				throw std::runtime_error("Cannot call gdwg::unordered_graph<N, E>::connections if src "
+				                         "doesn't exist in the graph");
+			}
+			auto result = std::vector<N>{};
+			result.reserve(it_src->second.size());
+			for (auto const& [dst, weights] : it_src->second) {
+				result.push_back(dst);
+			}
+			return result;
+		}
+
+		[[nodiscard]] auto num_edges() const noexcept -> std::size_t {
+			return num_edges_;
+		}
+
+		//--------------------------------- range access ------------------------------------
+		[[nodiscard]] auto begin() const -> iterator {
+			return iterator(out_.begin(), out_.end());
+		}
+
+		[[nodiscard]] auto end() const -> iterator {
+			return iterator(out_.end(), out_.end());
+		}
+
+		// ------------------------------ comparisons --------------------------------------
+		// same nodes and same edges, whatever their order
+		[[nodiscard]] auto operator==(unordered_graph const& other) const -> bool {
+			return num_edges_ == other.num_edges_ and out_ == other.out_;
+		}
+
+		// ------------------------------ Iterator -----------------------------------------
+		// forward iterator over every edge: node by node, dst by dst, weight by weight
+		class iterator {
+		private:
+			using outer_iter = typename node_map::const_iterator;
+			using middle_iter = typename adjacency::const_iterator;
+			using inner_iter = typename weight_set::const_iterator;
+
+		public:
+			using value_type = ranges::common_tuple<N, N, E>;
+			using reference = ranges::common_tuple<N const&, N const&, E const&>;
+			using difference_type = std::ptrdiff_t;
+			using iterator_category = std::forward_iterator_tag;
+
+			iterator() = default;
+
+			auto operator*() const -> reference {
+				return reference{outer_->first, middle_->first, *inner_};
+			}
+
+			auto operator++() -> iterator& {
+				++inner_;
+				if (inner_ == middle_->second.end()) {
+					++middle_;
+					skip_empty();
+				}
+				return *this;
+			}
+			auto operator++(int) -> iterator {
+				auto temp = *this;
+				++*this;
+				return temp;
+			}
+
+			auto operator==(iterator const& other) const -> bool {
+				if (outer_ != other.outer_) {
+					return false;
+				}
+				return outer_ == outer_end_ or (middle_ == other.middle_ and inner_ == other.inner_);
+			}
+
+		private:
+			friend class unordered_graph;
+
+			// first edge at or after outer
+			iterator(outer_iter outer, outer_iter outer_end)
+			: outer_{outer}
+			, outer_end_{outer_end} {
+				if (outer_ != outer_end_) {
+					middle_ = outer_->second.begin();
+					skip_empty();
+				}
+			}
+
+			iterator(outer_iter outer, outer_iter outer_end, middle_iter middle, inner_iter inner)
+			: outer_{outer}
+			, outer_end_{outer_end}
+			, middle_{middle}
+			, inner_{inner} {}
+
+			// weight sets are never empty ==> only nodes without outgoing edges are skipped
+			auto skip_empty() -> void {
+				while (middle_ == outer_->second.end()) {
+					++outer_;
+					if (outer_ == outer_end_) {
+						return;
+					}
+					middle_ = outer_->second.begin();
+				}
+				inner_ = middle_->second.begin();
+			}
+
+			outer_iter outer_;
+			outer_iter outer_end_;
+			middle_iter middle_;
+			inner_iter inner_;
+		};
+
+	private:
+		// src -> dst -> weights, and the in-neighbours of every node for erase / merge_replace
+		node_map out_;
+		absl::flat_hash_map<N, absl::flat_hash_set<N>> in_;
+		std::size_t num_edges_ = 0;
+	};
+} // namespace gdwg
+
+#endif // GDWG_UNORDERED_GRAPH_HPP
@@ -3,6 +3,7 @@
 #include <fmt/format.h>
 #include <fmt/ostream.h>
 #include <string>
+#include <tuple>
 #include <vector>
 
 //-------------------------------------------------------------------------------------------------
@@ -127,6 +128,62 @@ TEST_CASE("find") {
 	CHECK(it == g2.end());
 }
 
+// auto enable_edge_filter(std::size_t expected_edges = 0) -> void;
+// the bloom filter only short-circuits negative queries: results must not change whether it is on
+// or off, including after the filter has grown or been rebuilt
+TEST_CASE("edge filter") {
+	SECTION("answers are the same with and without the filter") {
+		auto g = gdwg::graph<int, int>{};
+		for (auto i = 0; i < 50; ++i) {
+			g.insert_node(i);
+		}
+		g.enable_edge_filter(4); // deliberately too small ==> must grow
+		CHECK(g.edge_filter_enabled());
+		for (auto i = 0; i < 50; ++i) {
+			g.insert_edge(i, (i * 7) % 50, i);
+		}
+		for (auto i = 0; i < 50; ++i) {
+			for (auto j = 0; j < 50; ++j) {
+				auto const expected = j == (i * 7) % 50;
+				CHECK(g.is_connected(i, j) == expected);
+				CHECK((g.find(i, j, i) != g.end()) == expected);
+			}
+		}
+	}
+	SECTION("erase, merge_replace and copies keep the filter consistent") {
+		auto g = gdwg::graph<int, std::string>{1, 2, 3, 4};
+		g.enable_edge_filter();
+		g.insert_edge(1, 2, "cat");
+		g.insert_edge(2, 3, "dog");
+		g.insert_edge(3, 1, "pig");
+		CHECK(g.erase_edge(1, 2, "cat"));
+		CHECK(not g.is_connected(1, 2));
+
+		g.merge_replace_node(3, 4);
+		CHECK(g.is_connected(2, 4));
+		CHECK(g.is_connected(4, 1));
+		CHECK(g.find(4, 1, "pig") != g.end());
+
+		auto const copy = g;
+		CHECK(copy.edge_filter_enabled());
+		CHECK(copy.is_connected(2, 4));
+		CHECK(not copy.is_connected(1, 2));
+
+		g.erase_node(4);
+		CHECK(not g.is_connected(2, 1));
+		g.disable_edge_filter();
+		CHECK(not g.edge_filter_enabled());
+		CHECK(copy.find(4, 1, "pig") != copy.end());
+	}
+	// find() never throws: unknown nodes simply give end()
+	SECTION("find with unknown nodes") {
+		auto g = gdwg::graph<int, std::string>{1, 2};
+		g.enable_edge_filter();
+		g.insert_edge(1, 2, "cat");
+		CHECK(g.find(1, 5, "cat") == g.end());
+	}
+}
+
 // [[nodiscard]] auto connections(N const& src) -> std::vector<N>;
 // Returns: A sequence of nodes (found from any immediate outgoing edge) connected to src, sorted in
 // ascending order, with respect to the connected nodes.
@@ -159,6 +216,219 @@ TEST_CASE("connections") {
 	}
 }
 
+// auto enable_query_cache(std::size_t capacity) -> void;
+// cached connections() and weights() must be dropped by every modifier touching their source
+TEST_CASE("query cache") {
+	auto g = gdwg::graph<int, int>{1, 2, 3, 4};
+	g.enable_query_cache(2);
+	REQUIRE(g.query_cache_enabled());
+	g.insert_edge(1, 2, 5);
+	g.insert_edge(3, 1, 7);
+	CHECK(g.connections(1) == std::vector<int>{2});
+	CHECK(g.weights(1, 2) == std::vector<int>{5});
+
+	SECTION("insert_edge and erase_edge") {
+		g.insert_edge(1, 3, 1);
+		g.insert_edge(1, 2, 4);
+		CHECK(g.connections(1) == std::vector<int>{2, 3});
+		CHECK(g.weights(1, 2) == std::vector<int>{4, 5});
+		g.erase_edge(1, 2, 4);
+		CHECK(g.weights(1, 2) == std::vector<int>{5});
+		g.erase_edge(g.find(1, 2, 5));
+		CHECK(g.connections(1) == std::vector<int>{3});
+		CHECK(g.weights(1, 2).empty());
+	}
+	SECTION("erase_node") {
+		CHECK(g.connections(3) == std::vector<int>{1});
+		g.erase_node(2);
+		CHECK(g.connections(1).empty());
+		g.erase_node(1);
+		CHECK(g.connections(3).empty());
+		g.insert_node(1);
+		CHECK(g.connections(1).empty());
+	}
+	SECTION("replace_node and merge_replace_node") {
+		CHECK(g.connections(3) == std::vector<int>{1});
+		g.replace_node(1, 9);
+		CHECK(g.connections(3) == std::vector<int>{9});
+		CHECK(g.weights(9, 2) == std::vector<int>{5});
+		g.merge_replace_node(9, 4);
+		CHECK(g.connections(4) == std::vector<int>{2});
+		CHECK(g.connections(3) == std::vector<int>{4});
+	}
+	SECTION("copies and moves") {
+		// a copy starts with an empty cache of the same capacity
+		auto copy = g;
+		CHECK(copy.query_cache_enabled());
+		copy.insert_edge(1, 4, 2);
+		CHECK(copy.connections(1) == std::vector<int>{2, 4});
+		CHECK(g.connections(1) == std::vector<int>{2});
+		// a moved cache keeps its entries, which follow the moved graph
+		auto moved = std::move(copy);
+		CHECK(moved.connections(1) == std::vector<int>{2, 4});
+		moved.erase_edge(1, 4, 2);
+		CHECK(moved.connections(1) == std::vector<int>{2});
+		copy = g;
+		CHECK(copy.weights(1, 2) == std::vector<int>{5});
+	}
+	SECTION("clear and disable") {
+		g.clear();
+		g.insert_node(1);
+		g.insert_node(2);
+		CHECK(g.connections(1).empty());
+		CHECK(g.weights(1, 2).empty());
+		g.disable_query_cache();
+		CHECK(not g.query_cache_enabled());
+	}
+}
+
+// [[nodiscard]] auto k_lightest_out_edges(N const& src, std::size_t k) -> std::vector<iterator>;
+// [[nodiscard]] auto k_heaviest_out_edges(N const& src, std::size_t k) -> std::vector<iterator>;
+// the weight ordered index is built on first use and has to follow every modifier afterwards
+TEST_CASE("k lightest and heaviest out edges") {
+	using graph = gdwg::graph<int, int>;
+	auto g = graph{1, 2, 3, 4};
+	g.insert_edge(1, 2, 5);
+	g.insert_edge(1, 3, 1);
+	g.insert_edge(1, 2, 3);
+	g.insert_edge(1, 4, 9);
+	g.insert_edge(2, 1, 0);
+	auto const edges = [](std::vector<graph::iterator> const& its) {
+		auto result = std::vector<std::tuple<int, int, int>>{};
+		for (auto const& it : its) {
+			auto const& [from, to, weight] = *it;
+			result.emplace_back(from, to, weight);
+		}
+		return result;
+	};
+	using edge = std::tuple<int, int, int>;
+	CHECK(edges(g.k_lightest_out_edges(1, 2)) == std::vector<edge>{{1, 3, 1}, {1, 2, 3}});
+	CHECK(edges(g.k_heaviest_out_edges(1, 2)) == std::vector<edge>{{1, 4, 9}, {1, 2, 5}});
+	CHECK(g.k_lightest_out_edges(1, 10).size() == 4);
+	CHECK(g.k_lightest_out_edges(3, 1).empty());
+	CHECK(g.k_heaviest_out_edges(1, 0).empty());
+
+	SECTION("insert and erase after the index is built") {
+		g.insert_edge(1, 1, -2);
+		g.erase_edge(1, 4, 9);
+		g.erase_edge(g.find(1, 3, 1));
+		CHECK(edges(g.k_lightest_out_edges(1, 2)) == std::vector<edge>{{1, 1, -2}, {1, 2, 3}});
+		CHECK(edges(g.k_heaviest_out_edges(1, 1)) == std::vector<edge>{{1, 2, 5}});
+	}
+	SECTION("update_weight, replace and erase_node") {
+		g.update_weight(g.find(1, 2, 5), 0);
+		CHECK(edges(g.k_lightest_out_edges(1, 1)) == std::vector<edge>{{1, 2, 0}});
+		g.replace_node(2, 7);
+		CHECK(edges(g.k_lightest_out_edges(7, 1)) == std::vector<edge>{{7, 1, 0}});
+		CHECK(edges(g.k_heaviest_out_edges(1, 1)) == std::vector<edge>{{1, 4, 9}});
+		g.erase_node(4);
+		CHECK(edges(g.k_heaviest_out_edges(1, 5))
+		      == std::vector<edge>{{1, 7, 3}, {1, 3, 1}, {1, 7, 0}});
+	}
+	SECTION("copy, move and clear") {
+		auto copy = g;
+		copy.insert_edge(1, 1, 100);
+		CHECK(edges(copy.k_heaviest_out_edges(1, 1)) == std::vector<edge>{{1, 1, 100}});
+		auto moved = std::move(copy);
+		moved.insert_edge(1, 1, 50);
+		CHECK(edges(moved.k_heaviest_out_edges(1, 2)) == std::vector<edge>{{1, 1, 100}, {1, 1, 50}});
+		g.clear();
+		g.insert_node(1);
+		CHECK(g.k_lightest_out_edges(1, 3).empty());
+	}
+	SECTION("exceptions") {
+		CHECK_THROWS_MATCHES(g.k_lightest_out_edges(9, 1),
+		                     std::runtime_error,
+		                     Catch::Matchers::Message("Cannot call gdwg::graph<N, E>::"
+		                                              "k_lightest_out_edges if src doesn't exist in "
+		                                              "the graph"));
+		CHECK_THROWS_MATCHES(g.k_heaviest_out_edges(9, 1),
+		                     std::runtime_error,
+		                     Catch::Matchers::Message("Cannot call gdwg::graph<N, E>::"
+		                                              "k_heaviest_out_edges if src doesn't exist in "
+		                                              "the graph"));
+	}
+}
+
+// [[nodiscard]] auto edges_with_weight_in(E const& lo, E const& hi) -> std::vector<iterator>;
+// [[nodiscard]] auto count_edges_with_weight_in(E const& lo, E const& hi) -> std::size_t;
+// edges with lo <= weight <= hi, lightest first
+TEST_CASE("edges with weight in") {
+	using graph = gdwg::graph<std::string, double>;
+	auto g = graph{"a", "b", "c"};
+	g.insert_edge("a", "b", 2.5);
+	g.insert_edge("b", "c", 0.5);
+	g.insert_edge("c", "a", 2.5);
+	g.insert_edge("a", "a", 9.0);
+	using edge = std::tuple<std::string, std::string, double>;
+	auto const edges = [](std::vector<graph::iterator> const& its) {
+		auto result = std::vector<edge>{};
+		for (auto const& it : its) {
+			auto const& [from, to, weight] = *it;
+			result.emplace_back(from, to, weight);
+		}
+		return result;
+	};
+
+	CHECK(edges(g.edges_with_weight_in(0.5, 2.5))
+	      == std::vector<edge>{{"b", "c", 0.5}, {"a", "b", 2.5}, {"c", "a", 2.5}});
+	CHECK(g.count_edges_with_weight_in(1.0, 9.0) == 3);
+	CHECK(g.count_edges_with_weight_in(3.0, 1.0) == 0);
+	CHECK(g.edges_with_weight_in(10.0, 20.0).empty());
+
+	g.merge_replace_node("c", "b");
+	g.insert_edge("b", "a", 1.0);
+	CHECK(edges(g.edges_with_weight_in(0.0, 2.0))
+	      == std::vector<edge>{{"b", "b", 0.5}, {"b", "a", 1.0}});
+	auto moved = std::move(g);
+	moved.erase_edge("a", "a", 9.0);
+	CHECK(moved.count_edges_with_weight_in(0.0, 100.0) == 4);
+	moved.clear();
+	CHECK(moved.count_edges_with_weight_in(0.0, 100.0) == 0);
+}
+
+// [[nodiscard]] auto reachable_with_max_weight(N const& src, N const& dst, E const& max_weight)
+//    -> bool;
+// [[nodiscard]] auto reachable_with_max_weight(N const& src, E const& max_weight)
+//    -> std::vector<N>;
+// paths only made of edges with weight <= max_weight
+TEST_CASE("reachable with max weight") {
+	using graph = gdwg::graph<int, int>;
+	auto g = graph{1, 2, 3, 4, 5};
+	g.insert_edge(1, 2, 10);
+	g.insert_edge(1, 2, 3);
+	g.insert_edge(2, 3, 5);
+	g.insert_edge(3, 4, 1);
+	g.insert_edge(1, 4, 8);
+	g.insert_edge(4, 1, 0);
+
+	CHECK(g.reachable_with_max_weight(1, 3, 5));
+	CHECK_FALSE(g.reachable_with_max_weight(1, 3, 4));
+	// through the heavier direct edge
+	CHECK(g.reachable_with_max_weight(1, 4, 8));
+	CHECK_FALSE(g.reachable_with_max_weight(1, 5, 100));
+	CHECK(g.reachable_with_max_weight(5, 5, 0));
+	CHECK(g.reachable_with_max_weight(4, 1, 0));
+	CHECK_FALSE(g.reachable_with_max_weight(3, 1, 0));
+	CHECK(g.reachable_with_max_weight(3, 1, 1));
+
+	CHECK(g.reachable_with_max_weight(1, 2) == std::vector<int>{1});
+	CHECK(g.reachable_with_max_weight(1, 3) == std::vector<int>{1, 2});
+	CHECK(g.reachable_with_max_weight(2, 5) == std::vector<int>{1, 2, 3, 4});
+	CHECK(graph{7}.reachable_with_max_weight(7, 0) == std::vector<int>{7});
+
+	CHECK_THROWS_MATCHES(g.reachable_with_max_weight(1, 6, 1),
+	                     std::runtime_error,
+	                     Catch::Matchers::Message("Cannot call gdwg::graph<N, E>::"
+	                                              "reachable_with_max_weight if src or dst node "
+	                                              "don't exist in the graph"));
+	CHECK_THROWS_MATCHES(g.reachable_with_max_weight(6, 1),
+	                     std::runtime_error,
+	                     Catch::Matchers::Message("Cannot call gdwg::graph<N, E>::"
+	                                              "reachable_with_max_weight if src doesn't exist "
+	                                              "in the graph"));
+}
+
 // comparison
 // [[nodiscard]] auto operator==(graph const& other) -> bool;
 // return true iff all nodes and edges in 2 graphs are equal
@@ -0,0 +1,164 @@
+#include "gdwg/critical_path.hpp"
+#include "gdwg/graph.hpp"
+#include <algorithm>
+#include <catch2/catch.hpp>
+#include <cstddef>
+#include <random>
+#include <string>
+#include <tuple>
+#include <vector>
+
+//-------------------------------------------------------------------------------------------------
+//                                test critical_path and longest_path
+//-------------------------------------------------------------------------------------------------
+
+// explicit critical_path(graph<N, E>& g, std::size_t threads = 0);
+// [[nodiscard]] auto length() const -> E;
+// [[nodiscard]] auto earliest_start(N const& node) const -> E;
+// [[nodiscard]] auto latest_start(N const& node) const -> E;
+// [[nodiscard]] auto slack(N const& node) const -> E;
+// [[nodiscard]] auto nodes() const -> std::vector<N>;
+TEST_CASE("critical path of a project") {
+	auto g = gdwg::graph<std::string, int>{"design", "build", "docs", "test", "ship"};
+	g.insert_edge("design", "build", 3);
+	g.insert_edge("design", "docs", 3);
+	g.insert_edge("build", "test", 5);
+	g.insert_edge("docs", "ship", 2);
+	g.insert_edge("test", "ship", 2);
+
+	auto const cp = gdwg::critical_path(g);
+	CHECK(cp.length() == 10);
+	CHECK(cp.nodes() == std::vector<std::string>{"design", "build", "test", "ship"});
+	CHECK(cp.earliest_start("docs") == 3);
+	CHECK(cp.latest_start("docs") == 8);
+	CHECK(cp.slack("docs") == 5);
+	CHECK(cp.slack("build") == 0);
+	CHECK(cp.earliest_start("ship") == 10);
+	CHECK(cp.latest_start("design") == 0);
+	CHECK_THROWS_WITH(cp.slack("deploy"),
+	                  "Cannot call gdwg::critical_path<N, E>::slack on a node that doesn't exist in "
+	                  "the graph");
+
+	CHECK(gdwg::longest_path(g) == std::vector<std::string>{"design", "build", "test", "ship"});
+	auto empty = gdwg::graph<int, double>{};
+	CHECK(gdwg::critical_path(empty).length() == 0.0);
+	CHECK(gdwg::critical_path(empty).nodes().empty());
+
+	g.insert_edge("ship", "design", 1);
+	CHECK_THROWS_WITH(gdwg::critical_path(g),
+	                  "Cannot use gdwg::critical_path<N, E> on a graph with a cycle");
+	CHECK_THROWS_WITH(gdwg::longest_path(g),
+	                  "Cannot compute gdwg::longest_path of a graph with a cycle");
+}
+
+// auto update_weight(N const& src, N const& dst, E const& old_weight, E const& new_weight) -> bool;
+TEST_CASE("critical path follows weight updates") {
+	auto g = gdwg::graph<std::string, int>{"design", "build", "docs", "ship"};
+	g.insert_edge("design", "build", 3);
+	g.insert_edge("design", "docs", 3);
+	g.insert_edge("build", "ship", 5);
+	g.insert_edge("docs", "ship", 2);
+	auto cp = gdwg::critical_path(g);
+	CHECK(cp.length() == 8);
+
+	// docs becomes critical
+	CHECK(cp.update_weight("docs", "ship", 2, 7));
+	CHECK(g.weights("docs", "ship") == std::vector<int>{7});
+	CHECK(cp.length() == 10);
+	CHECK(cp.nodes() == std::vector<std::string>{"design", "docs", "ship"});
+	CHECK(cp.slack("build") == 2);
+
+	CHECK_FALSE(cp.update_weight("docs", "ship", 2, 1));
+	CHECK_THROWS_WITH(cp.update_weight("docs", "deploy", 2, 1),
+	                  "Cannot call gdwg::critical_path<N, E>::update_weight on src or dst if they "
+	                  "don't exist in the graph");
+
+	// merges into the existing edge of weight 3
+	g.insert_edge("design", "build", 1);
+	cp.recompute();
+	CHECK(cp.update_weight("design", "build", 1, 3));
+	CHECK(g.weights("design", "build") == std::vector<int>{3});
+	CHECK(cp.update_weight("design", "build", 3, 0));
+	CHECK(cp.earliest_start("build") == 0);
+	CHECK(cp.length() == 10);
+}
+
+// floating-point weights: the heads are summed forward and the tails backward, and the two round
+// differently (0.1 + 0.2 + 0.3 != 0.3 + 0.2 + 0.1)
+TEST_CASE("critical path with floating-point weights") {
+	auto g = gdwg::graph<int, double>{1, 2, 3, 4, 5};
+	g.insert_edge(1, 2, 0.1);
+	g.insert_edge(2, 3, 0.2);
+	g.insert_edge(3, 4, 0.3);
+	g.insert_edge(1, 5, 0.1);
+	g.insert_edge(5, 4, 0.1);
+
+	auto cp = gdwg::critical_path(g);
+	CHECK(cp.nodes() == std::vector<int>{1, 2, 3, 4});
+	CHECK(gdwg::longest_path(g) == std::vector<int>{1, 2, 3, 4});
+	CHECK(cp.length() == Approx(0.6));
+	for (auto const v : {1, 2, 3, 4}) {
+		CHECK(cp.slack(v) == 0.0);
+	}
+	CHECK(cp.latest_start(1) == 0.0);
+	CHECK(cp.slack(5) == Approx(0.4));
+
+	// the side branch becomes critical
+	CHECK(cp.update_weight(5, 4, 0.1, 0.7));
+	CHECK(cp.nodes() == std::vector<int>{1, 5, 4});
+	CHECK(cp.length() == Approx(0.8));
+	CHECK(cp.slack(5) == 0.0);
+	CHECK(cp.slack(2) == Approx(0.2));
+}
+
+// random DAGs and random weight changes: the incremental times always equal a full recomputation,
+// and the parallel wavefront (5000 nodes) equals the sequential one
+TEST_CASE("critical path incremental updates match recomputation") {
+	auto const n = GENERATE(60, 5000);
+	auto engine = std::mt19937(6771);
+	auto g = gdwg::graph<int, int>{};
+	for (auto i = 0; i < n; ++i) {
+		g.insert_node(i);
+	}
+	auto pick = std::uniform_int_distribution<int>(0, n - 1);
+	auto weight = std::uniform_int_distribution<int>(-5, 40);
+	for (auto i = 0; i < 3 * n; ++i) {
+		auto const a = pick(engine);
+		auto const b = pick(engine);
+		if (a != b) {
+			g.insert_edge(std::min(a, b), std::max(a, b), weight(engine));
+		}
+	}
+
+	auto cp = gdwg::critical_path(g, 4);
+	auto const edges = [&] {
+		auto result = std::vector<std::tuple<int, int, int>>{};
+		for (auto const& [from, to, w] : g) {
+			result.emplace_back(from, to, w);
+		}
+		return result;
+	};
+	auto current = edges();
+	for (auto i = 0; i < 50; ++i) {
+		auto const index = static_cast<std::size_t>(pick(engine)) % current.size();
+		auto const [from, to, old_weight] = current[index];
+		REQUIRE(cp.update_weight(from, to, old_weight, weight(engine)));
+		current = edges();
+
+		auto const expected = gdwg::critical_path(g, 1);
+		REQUIRE(cp.length() == expected.length());
+		for (auto j = 0; j < 20; ++j) {
+			auto const node = pick(engine);
+			REQUIRE(cp.earliest_start(node) == expected.earliest_start(node));
+			REQUIRE(cp.slack(node) == expected.slack(node));
+		}
+	}
+	auto const path = cp.nodes();
+	auto total = 0;
+	for (auto i = std::size_t{1}; i < path.size(); ++i) {
+		auto const w = g.weights(path[i - 1], path[i]);
+		REQUIRE_FALSE(w.empty());
+		total += w.back();
+	}
+	CHECK(total == cp.length());
+}
@@ -0,0 +1,176 @@
+#include "gdwg/dag.hpp"
+#include "gdwg/graph.hpp"
+#include <catch2/catch.hpp>
+#include <cstddef>
+#include <map>
+#include <random>
+#include <string>
+#include <vector>
+
+//-------------------------------------------------------------------------------------------------
+//                                test dag
+//-------------------------------------------------------------------------------------------------
+
+namespace {
+	// every edge goes forward in the order, which holds every node once
+	template<typename N, typename E>
+	auto is_topological(gdwg::dag<N, E> const& d) -> bool {
+		auto const order = d.topological_order();
+		auto position = std::map<N, std::size_t>{};
+		for (auto i = std::size_t{0}; i < order.size(); ++i) {
+			position[order[i]] = i;
+		}
+		if (position.size() != order.size() or order.size() != d.nodes().size()) {
+			return false;
+		}
+		for (auto const& [from, to, weight] : d) {
+			if (not(position.at(from) < position.at(to))) {
+				return false;
+			}
+		}
+		return true;
+	}
+
+	auto reaches(gdwg::graph<int, int> const& g, int src, int dst) -> bool {
+		auto seen = std::map<int, bool>{{src, true}};
+		auto stack = std::vector<int>{src};
+		while (not stack.empty()) {
+			auto const u = stack.back();
+			stack.pop_back();
+			if (u == dst) {
+				return true;
+			}
+			for (auto const v : g.connections(u)) {
+				if (not seen[v]) {
+					seen[v] = true;
+					stack.push_back(v);
+				}
+			}
+		}
+		return false;
+	}
+} // namespace
+
+// auto insert_edge(N const& src, N const& dst, E const& weight) -> bool;
+// [[nodiscard]] auto topological_order() const -> std::vector<N>;
+// [[nodiscard]] auto precedes(N const& a, N const& b) const -> bool;
+TEST_CASE("dag rejects edges closing a cycle") {
+	auto d = gdwg::dag<std::string, int>{"c", "b", "a"};
+	CHECK(d.topological_order() == std::vector<std::string>{"c", "b", "a"});
+
+	// against the order: c and b move after a
+	CHECK(d.insert_edge("a", "b", 1));
+	CHECK(d.insert_edge("b", "c", 1));
+	CHECK_FALSE(d.insert_edge("b", "c", 1));
+	CHECK(d.insert_edge("b", "c", 2));
+	CHECK(d.topological_order() == std::vector<std::string>{"a", "b", "c"});
+	CHECK(d.precedes("a", "c"));
+	CHECK_FALSE(d.precedes("c", "a"));
+
+	CHECK_THROWS_WITH(d.insert_edge("c", "a", 1),
+	                  "Cannot call gdwg::dag<N, E>::insert_edge with an edge that would create a "
+	                  "cycle");
+	CHECK_THROWS_WITH(d.insert_edge("b", "b", 1),
+	                  "Cannot call gdwg::dag<N, E>::insert_edge with an edge that would create a "
+	                  "cycle");
+	CHECK_THROWS_WITH(d.insert_edge("a", "z", 1),
+	                  "Cannot call gdwg::dag<N, E>::insert_edge when either src or dst node does "
+	                  "not exist");
+	CHECK_THROWS_WITH(d.precedes("a", "z"),
+	                  "Cannot call gdwg::dag<N, E>::precedes on nodes that don't exist in the "
+	                  "graph");
+	// a rejected edge changes nothing
+	CHECK(d.as_graph().weights("c", "a").empty());
+	CHECK(d.topological_order() == std::vector<std::string>{"a", "b", "c"});
+
+	// once b -> c is gone, c -> b is allowed
+	CHECK(d.erase_edge("b", "c", 1));
+	CHECK(d.erase_edge("b", "c", 2));
+	CHECK(d.insert_edge("c", "b", 1));
+	CHECK(d.topological_order() == std::vector<std::string>{"a", "c", "b"});
+	CHECK(is_topological(d));
+}
+
+// auto insert_node(N const& value) -> bool;
+// auto replace_node(N const& old_data, N const& new_data) -> bool;
+// auto erase_node(N const& value) -> bool;
+// auto update_weight(N const& src, N const& dst, E const& old_weight, E const& new_weight) -> bool;
+TEST_CASE("dag nodes") {
+	auto d = gdwg::dag<int, int>{1, 2, 3};
+	d.insert_edge(3, 2, 0);
+	d.insert_edge(2, 1, 0);
+	CHECK_FALSE(d.insert_node(2));
+	CHECK(d.insert_node(4));
+	CHECK(d.topological_order() == std::vector<int>{3, 2, 1, 4});
+
+	CHECK(d.replace_node(2, 5));
+	CHECK_FALSE(d.replace_node(5, 4));
+	CHECK_THROWS_WITH(d.replace_node(2, 6),
+	                  "Cannot call gdwg::dag<N, E>::replace_node on a node that doesn't exist");
+	CHECK(d.topological_order() == std::vector<int>{3, 5, 1, 4});
+	CHECK_THROWS(d.insert_edge(1, 3, 0));
+
+	CHECK(d.update_weight(3, 5, 0, 7));
+	CHECK(d.weights(3, 5) == std::vector<int>{7});
+
+	CHECK(d.erase_node(5));
+	CHECK_FALSE(d.erase_node(5));
+	CHECK(d.topological_order() == std::vector<int>{3, 1, 4});
+	// the cycle went with 5
+	CHECK(d.insert_edge(1, 3, 0));
+	CHECK(d.insert_node(6));
+	CHECK(d.insert_edge(6, 1, 0));
+	CHECK(is_topological(d));
+
+	d.clear();
+	CHECK(d.empty());
+	CHECK(d.topological_order().empty());
+}
+
+// explicit dag(graph<N, E> const& g);
+TEST_CASE("dag from a graph") {
+	auto g = gdwg::graph<int, int>{1, 2, 3, 4};
+	g.insert_edge(4, 1, 1);
+	g.insert_edge(3, 4, 1);
+	auto d = gdwg::dag<int, int>(g);
+	CHECK(d.as_graph() == g);
+	CHECK(is_topological(d));
+	CHECK_THROWS(d.insert_edge(1, 3, 1));
+	CHECK(d.insert_edge(2, 3, 1));
+
+	g.insert_edge(1, 3, 1);
+	CHECK_THROWS_WITH((gdwg::dag<int, int>(g)),
+	                  "Cannot create gdwg::dag<N, E> from a graph with a cycle");
+}
+
+// random edges: accepted exactly when dst doesn't reach src, and the order stays topological
+TEST_CASE("dag accepts exactly the acyclic edges") {
+	auto engine = std::mt19937(6771);
+	auto pick = std::uniform_int_distribution<int>(0, 39);
+	auto d = gdwg::dag<int, int>{};
+	for (auto i = 0; i < 40; ++i) {
+		d.insert_node(i);
+	}
+	for (auto i = 0; i < 600; ++i) {
+		auto const from = pick(engine);
+		auto const to = pick(engine);
+		if (i % 7 == 0 and d.as_graph().begin() != d.as_graph().end()) {
+			// copies: the edge refers to the values it is about to release
+			auto const [src, dst, weight] = *d.as_graph().begin();
+			REQUIRE(d.erase_edge(int{src}, int{dst}, int{weight}));
+			continue;
+		}
+		if (i % 97 == 0) {
+			d.erase_node(from);
+			d.insert_node(from);
+		}
+		auto const cycle = reaches(d.as_graph(), to, from);
+		if (cycle) {
+			REQUIRE_THROWS(d.insert_edge(from, to, 1));
+		}
+		else {
+			d.insert_edge(from, to, 1);
+		}
+		REQUIRE(is_topological(d));
+	}
+}
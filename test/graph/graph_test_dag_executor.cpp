@@ -0,0 +1,113 @@
+#include "gdwg/dag_executor.hpp"
+#include "gdwg/graph.hpp"
+#include <atomic>
+#include <catch2/catch.hpp>
+#include <cstddef>
+#include <map>
+#include <mutex>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+//-------------------------------------------------------------------------------------------------
+//                                test dag_executor
+//-------------------------------------------------------------------------------------------------
+
+// explicit dag_executor(graph<N, E> const& g, std::size_t threads = 0);
+// [[nodiscard]] auto priority(N const& node) const -> E;
+TEST_CASE("dag executor priorities are the longest remaining durations") {
+	auto g = gdwg::graph<std::string, int>{"fetch", "parse", "index", "report", "lint"};
+	g.insert_edge("fetch", "parse", 2);
+	g.insert_edge("parse", "index", 5);
+	g.insert_edge("parse", "report", 1);
+	g.insert_edge("fetch", "report", 4);
+	g.insert_edge("fetch", "report", 9);
+
+	auto const executor = gdwg::dag_executor(g, 2);
+	CHECK(executor.threads() == 2);
+	CHECK(executor.priority("fetch") == 9);
+	CHECK(executor.priority("parse") == 5);
+	CHECK(executor.priority("index") == 0);
+	CHECK(executor.priority("lint") == 0);
+	CHECK_THROWS_WITH(executor.priority("deploy"),
+	                  "Cannot call gdwg::dag_executor<N, E>::priority on a node that doesn't exist "
+	                  "in the graph");
+
+	g.insert_edge("index", "fetch", 1);
+	CHECK_THROWS_WITH(gdwg::dag_executor(g),
+	                  "Cannot create gdwg::dag_executor<N, E> from a graph with a cycle");
+}
+
+// template<typename F> auto run(F&& task) -> void;
+TEST_CASE("dag executor runs the most urgent ready task first") {
+	// b heads the longer chain ==> runs before a although a is smaller
+	auto g = gdwg::graph<char, int>{'a', 'b', 'c', 'd'};
+	g.insert_edge('a', 'd', 1);
+	g.insert_edge('b', 'c', 3);
+	g.insert_edge('c', 'd', 1);
+	auto executor = gdwg::dag_executor(g, 1);
+	auto order = std::string{};
+	executor.run([&](char node) { order += node; });
+	CHECK(order == "bcad");
+
+	// runs again from scratch
+	order.clear();
+	executor.run([&](char node) { order += node; });
+	CHECK(order == "bcad");
+
+	auto none = gdwg::dag_executor(gdwg::graph<char, int>{}, 4);
+	none.run([](char) { FAIL("no node to run"); });
+}
+
+// every task starts after all its predecessors finished, on several threads
+TEST_CASE("dag executor respects dependencies") {
+	auto engine = std::mt19937(6771);
+	auto const n = 2000;
+	auto g = gdwg::graph<int, int>{};
+	for (auto i = 0; i < n; ++i) {
+		g.insert_node(i);
+	}
+	auto pick = std::uniform_int_distribution<int>(0, n - 1);
+	auto duration = std::uniform_int_distribution<int>(1, 10);
+	for (auto i = 0; i < 4 * n; ++i) {
+		auto const a = pick(engine);
+		auto const b = pick(engine);
+		if (a != b) {
+			g.insert_edge(std::min(a, b), std::max(a, b), duration(engine));
+		}
+	}
+
+	auto executor = gdwg::dag_executor(g, 4);
+	auto clock = std::atomic<int>{0};
+	auto started = std::vector<int>(n, -1);
+	auto finished = std::vector<int>(n, -1);
+	auto runs = std::atomic<int>{0};
+	executor.run([&](int node) {
+		started[static_cast<std::size_t>(node)] = clock.fetch_add(1);
+		++runs;
+		finished[static_cast<std::size_t>(node)] = clock.fetch_add(1);
+	});
+	CHECK(runs == n);
+	for (auto const& [from, to, weight] : g) {
+		REQUIRE(finished[static_cast<std::size_t>(from)] < started[static_cast<std::size_t>(to)]);
+	}
+}
+
+TEST_CASE("dag executor stops at the first exception") {
+	auto g = gdwg::graph<int, int>{1, 2, 3};
+	g.insert_edge(1, 2, 1);
+	g.insert_edge(2, 3, 1);
+	auto executor = gdwg::dag_executor(g, 2);
+	auto ran = std::vector<int>{};
+	auto mutex = std::mutex{};
+	CHECK_THROWS_WITH(executor.run([&](int node) {
+		                  auto const lock = std::lock_guard(mutex);
+		                  ran.push_back(node);
+		                  if (node == 2) {
+			                  throw std::runtime_error("task 2 failed");
+		                  }
+	                  }),
+	                  "task 2 failed");
+	CHECK(ran == std::vector<int>{1, 2});
+}
@@ -0,0 +1,68 @@
+#include "gdwg/diff.hpp"
+#include "gdwg/graph.hpp"
+#include <catch2/catch.hpp>
+#include <random>
+#include <string>
+#include <vector>
+
+//-------------------------------------------------------------------------------------------------
+//                                test diff and apply
+//-------------------------------------------------------------------------------------------------
+
+// [[nodiscard]] auto diff(graph<N, E> const& a, graph<N, E> const& b) -> graph_diff<N, E>;
+// auto apply(graph<N, E>& g, graph_diff<N, E> const& d) -> void;
+TEST_CASE("diff lists the minimal mutations") {
+	using graph = gdwg::graph<std::string, int>;
+	auto a = graph{"sydney", "perth", "darwin", "hobart"};
+	a.insert_edge("sydney", "perth", 5);
+	a.insert_edge("sydney", "darwin", 3);
+	a.insert_edge("hobart", "sydney", 1);
+	a.insert_edge("perth", "perth", 2);
+	auto b = graph{"sydney", "perth", "darwin", "adelaide"};
+	b.insert_edge("sydney", "perth", 5);
+	b.insert_edge("sydney", "perth", 6);
+	b.insert_edge("adelaide", "darwin", 4);
+
+	auto const d = gdwg::diff(a, b);
+	CHECK(d.erased_nodes == std::vector<std::string>{"hobart"});
+	CHECK(d.inserted_nodes == std::vector<std::string>{"adelaide"});
+	// hobart -> sydney goes with hobart
+	REQUIRE(d.erased_edges.size() == 2);
+	CHECK(d.erased_edges[0].from == "perth");
+	CHECK(d.erased_edges[1].to == "darwin");
+	REQUIRE(d.inserted_edges.size() == 2);
+	CHECK(d.inserted_edges[0].from == "adelaide");
+	CHECK(d.inserted_edges[1].weight == 6);
+
+	gdwg::apply(a, d);
+	CHECK(a == b);
+	CHECK(gdwg::diff(a, b).empty());
+	CHECK(gdwg::diff(graph{}, graph{}).empty());
+}
+
+// random pairs of graphs: applying the diff always gives the second graph
+TEST_CASE("apply(a, diff(a, b)) == b") {
+	auto engine = std::mt19937(6771);
+	auto value = std::uniform_int_distribution<int>(0, 11);
+	auto const random_graph = [&] {
+		auto g = gdwg::graph<int, int>{};
+		for (auto i = 0; i < 12; ++i) {
+			if (value(engine) < 9) {
+				g.insert_node(i);
+			}
+		}
+		auto const nodes = g.nodes();
+		for (auto i = 0; i < 40 and not nodes.empty(); ++i) {
+			auto const from = nodes[static_cast<std::size_t>(value(engine)) % nodes.size()];
+			auto const to = nodes[static_cast<std::size_t>(value(engine)) % nodes.size()];
+			g.insert_edge(from, to, value(engine) % 3);
+		}
+		return g;
+	};
+	for (auto round = 0; round < 50; ++round) {
+		auto a = random_graph();
+		auto const b = random_graph();
+		gdwg::apply(a, gdwg::diff(a, b));
+		REQUIRE(a == b);
+	}
+}
@@ -0,0 +1,130 @@
+#include "gdwg/dominator_tree.hpp"
+#include "gdwg/graph.hpp"
+#include <catch2/catch.hpp>
+#include <optional>
+#include <random>
+#include <string>
+#include <vector>
+
+//-------------------------------------------------------------------------------------------------
+//                                test dominator_tree
+//-------------------------------------------------------------------------------------------------
+
+namespace {
+	// a control flow graph:
+	//   entry -> cond -> then -> join -> exit
+	//            cond -> else -> join
+	//            join -> cond (loop back edge)
+	//   dead -> join (unreachable block)
+	auto control_flow() -> gdwg::graph<std::string, int> {
+		auto g =
+		   gdwg::graph<std::string, int>{"entry", "cond", "then", "else", "join", "exit", "dead"};
+		g.insert_edge("entry", "cond", 0);
+		g.insert_edge("cond", "then", 0);
+		g.insert_edge("cond", "else", 0);
+		g.insert_edge("then", "join", 0);
+		g.insert_edge("else", "join", 0);
+		g.insert_edge("join", "cond", 0);
+		g.insert_edge("join", "exit", 0);
+		g.insert_edge("dead", "join", 0);
+		return g;
+	}
+} // namespace
+
+// dominator_tree(graph<N, E> const& g, N const& entry);
+// [[nodiscard]] auto immediate_dominator(N const& node) const -> std::optional<N>;
+// [[nodiscard]] auto dominates(N const& a, N const& b) const -> bool;
+// [[nodiscard]] auto children(N const& node) const -> std::vector<N>;
+// [[nodiscard]] auto is_reachable(N const& node) const -> bool;
+TEST_CASE("dominator tree of a loop with a branch") {
+	auto const g = control_flow();
+	auto const tree = gdwg::dominator_tree(g, std::string("entry"));
+	CHECK(tree.entry() == "entry");
+	CHECK(tree.immediate_dominator("entry") == std::nullopt);
+	CHECK(tree.immediate_dominator("cond") == "entry");
+	CHECK(tree.immediate_dominator("then") == "cond");
+	CHECK(tree.immediate_dominator("join") == "cond");
+	CHECK(tree.immediate_dominator("exit") == "join");
+	CHECK(tree.children("cond") == std::vector<std::string>{"else", "join", "then"});
+
+	CHECK(tree.dominates("entry", "exit"));
+	CHECK(tree.dominates("cond", "cond"));
+	CHECK_FALSE(tree.dominates("then", "join"));
+	CHECK_FALSE(tree.dominates("exit", "join"));
+
+	CHECK_FALSE(tree.is_reachable("dead"));
+	CHECK(tree.immediate_dominator("dead") == std::nullopt);
+	CHECK_FALSE(tree.dominates("entry", "dead"));
+	CHECK(tree.children("dead").empty());
+
+	CHECK_THROWS_WITH(tree.dominates("entry", "ret"),
+	                  "Cannot call gdwg::dominator_tree<N>::dominates on a node that doesn't exist "
+	                  "in the graph");
+	CHECK_THROWS_WITH(gdwg::dominator_tree(g, std::string("ret")),
+	                  "Cannot create gdwg::dominator_tree<N> from an entry that doesn't exist in "
+	                  "the graph");
+}
+
+// auto post_dominator_tree(graph<N, E> const& g, N const& exit) -> dominator_tree<N>;
+TEST_CASE("post dominator tree") {
+	auto const g = control_flow();
+	auto const tree = gdwg::post_dominator_tree(g, std::string("exit"));
+	CHECK(tree.entry() == "exit");
+	CHECK(tree.immediate_dominator("join") == "exit");
+	CHECK(tree.immediate_dominator("then") == "join");
+	CHECK(tree.immediate_dominator("cond") == "join");
+	CHECK(tree.immediate_dominator("entry") == "cond");
+	CHECK(tree.immediate_dominator("dead") == "join");
+	CHECK(tree.dominates("join", "entry"));
+	CHECK_FALSE(tree.dominates("then", "cond"));
+	CHECK_THROWS_WITH(gdwg::post_dominator_tree(g, std::string("ret")),
+	                  "Cannot create gdwg::post_dominator_tree from an exit that doesn't exist in "
+	                  "the graph");
+}
+
+// random graphs: a dominates b exactly when b can't be reached from the entry without a
+TEST_CASE("dominator tree matches removing nodes") {
+	auto engine = std::mt19937(6771);
+	auto pick = std::uniform_int_distribution<int>(0, 24);
+	for (auto round = 0; round < 20; ++round) {
+		auto g = gdwg::graph<int, int>{};
+		for (auto i = 0; i < 25; ++i) {
+			g.insert_node(i);
+		}
+		for (auto i = 0; i < 45; ++i) {
+			g.insert_edge(pick(engine), pick(engine), 0);
+		}
+		auto const tree = gdwg::dominator_tree(g, 0);
+		// nodes reached from 0 without going through removed
+		auto const reached = [&](int removed) {
+			auto seen = std::vector<bool>(25, false);
+			auto stack = std::vector<int>{};
+			if (removed != 0) {
+				seen[0] = true;
+				stack.push_back(0);
+			}
+			while (not stack.empty()) {
+				auto const u = stack.back();
+				stack.pop_back();
+				for (auto const v : g.connections(u)) {
+					if (v != removed and not seen[static_cast<std::size_t>(v)]) {
+						seen[static_cast<std::size_t>(v)] = true;
+						stack.push_back(v);
+					}
+				}
+			}
+			return seen;
+		};
+		auto const all = reached(-1);
+		for (auto a = 0; a < 25; ++a) {
+			auto const without = reached(a);
+			for (auto b = 0; b < 25; ++b) {
+				auto const reachable = all[static_cast<std::size_t>(b)];
+				REQUIRE(tree.is_reachable(b) == reachable);
+				auto const expected = reachable and all[static_cast<std::size_t>(a)]
+				                      and (a == b or not without[static_cast<std::size_t>(b)]);
+				REQUIRE(tree.dominates(a, b) == expected);
+			}
+		}
+	}
+}
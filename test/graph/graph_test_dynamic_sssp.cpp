@@ -0,0 +1,111 @@
+#include "gdwg/dynamic_sssp.hpp"
+#include "gdwg/graph.hpp"
+#include <catch2/catch.hpp>
+#include <optional>
+#include <random>
+#include <vector>
+
+//-------------------------------------------------------------------------------------------------
+//                        test incremental single source shortest paths
+//-------------------------------------------------------------------------------------------------
+
+// dynamic_sssp(graph<N, E>& g, N const& source);
+// distances are computed on construction, unreachable nodes have no distance
+TEST_CASE("dynamic_sssp construction") {
+	auto g = gdwg::graph<char, int>{'a', 'b', 'c', 'd'};
+	g.insert_edge('a', 'b', 4);
+	g.insert_edge('a', 'c', 1);
+	g.insert_edge('c', 'b', 2);
+	g.insert_edge('c', 'b', 1);
+	auto const sssp = gdwg::dynamic_sssp<char, int>(g, 'a');
+
+	CHECK(sssp.distance('a') == 0);
+	CHECK(sssp.distance('b') == 2);
+	CHECK(sssp.distance('c') == 1);
+	CHECK(sssp.distance('d') == std::nullopt);
+
+	SECTION("exceptions") {
+		CHECK_THROWS_MATCHES((gdwg::dynamic_sssp<char, int>(g, 'z')),
+		                     std::runtime_error,
+		                     Catch::Matchers::Message("Cannot create gdwg::dynamic_sssp<N, E> from a "
+		                                              "source that doesn't exist in the graph"));
+		auto h = gdwg::graph<char, int>{'a'};
+		h.insert_edge('a', 'a', -1);
+		CHECK_THROWS_AS((gdwg::dynamic_sssp<char, int>(h, 'a')), std::runtime_error);
+	}
+}
+
+// insert_edge / erase_edge / update_weight update the graph and the distances
+TEST_CASE("dynamic_sssp updates") {
+	auto g = gdwg::graph<char, int>{'a', 'b', 'c', 'd'};
+	g.insert_edge('a', 'b', 1);
+	g.insert_edge('b', 'c', 1);
+	g.insert_edge('c', 'd', 1);
+	auto sssp = gdwg::dynamic_sssp<char, int>(g, 'a');
+	REQUIRE(sssp.distance('d') == 3);
+
+	SECTION("a shortcut lowers the distances behind it") {
+		CHECK(sssp.insert_edge('a', 'c', 0));
+		CHECK(g.is_connected('a', 'c'));
+		CHECK(sssp.distance('c') == 0);
+		CHECK(sssp.distance('d') == 1);
+		CHECK(not sssp.insert_edge('a', 'c', 0));
+	}
+	SECTION("cutting a tree edge detaches or reroutes the subtree") {
+		CHECK(sssp.erase_edge('b', 'c', 1));
+		CHECK(sssp.distance('c') == std::nullopt);
+		CHECK(sssp.distance('d') == std::nullopt);
+		sssp.insert_edge('a', 'd', 7);
+		CHECK(sssp.distance('d') == 7);
+		CHECK(not sssp.erase_edge('b', 'c', 1));
+	}
+	SECTION("weight change") {
+		CHECK(sssp.update_weight('b', 'c', 1, 5));
+		CHECK(g.weights('b', 'c') == std::vector<int>{5});
+		CHECK(sssp.distance('d') == 7);
+		CHECK(not sssp.update_weight('b', 'c', 1, 5));
+		CHECK_THROWS_AS(sssp.update_weight('b', 'c', 5, -1), std::runtime_error);
+	}
+}
+
+// random edits must give the same distances as a computation from scratch
+TEST_CASE("dynamic_sssp matches recomputation") {
+	auto g = gdwg::graph<int, int>{};
+	for (auto i = 0; i < 30; ++i) {
+		g.insert_node(i);
+	}
+	auto sssp = gdwg::dynamic_sssp<int, int>(g, 0);
+	auto engine = std::mt19937(6771);
+	auto node = std::uniform_int_distribution<int>(0, 29);
+	auto weight = std::uniform_int_distribution<int>(0, 9);
+	auto inserted = std::vector<gdwg::graph<int, int>::value_type>{};
+
+	for (auto step = 0; step < 400; ++step) {
+		if (not inserted.empty() and step % 5 == 0) {
+			auto& e = inserted[static_cast<std::size_t>(step) % inserted.size()];
+			auto const new_weight = weight(engine);
+			if (g.find(e.from, e.to, new_weight) == g.end()) {
+				REQUIRE(sssp.update_weight(e.from, e.to, e.weight, new_weight));
+				e.weight = new_weight;
+			}
+		}
+		else if (inserted.empty() or step % 3 != 0) {
+			auto const e =
+			   gdwg::graph<int, int>::value_type{node(engine), node(engine), weight(engine)};
+			if (sssp.insert_edge(e.from, e.to, e.weight)) {
+				inserted.push_back(e);
+			}
+		}
+		else {
+			auto const index = static_cast<std::size_t>(step) % inserted.size();
+			auto const e = inserted[index];
+			inserted.erase(inserted.begin() + static_cast<std::ptrdiff_t>(index));
+			REQUIRE(sssp.erase_edge(e.from, e.to, e.weight));
+		}
+		auto copy = g;
+		auto const fresh = gdwg::dynamic_sssp<int, int>(copy, 0);
+		for (auto i = 0; i < 30; ++i) {
+			REQUIRE(sssp.distance(i) == fresh.distance(i));
+		}
+	}
+}
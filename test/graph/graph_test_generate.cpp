@@ -0,0 +1,91 @@
+#include "gdwg/generate.hpp"
+#include "gdwg/graph.hpp"
+#include <algorithm>
+#include <catch2/catch.hpp>
+#include <cstddef>
+#include <map>
+#include <tuple>
+#include <vector>
+
+//-------------------------------------------------------------------------------------------------
+//                              test the synthetic graph generators
+//-------------------------------------------------------------------------------------------------
+
+namespace {
+	template<typename Edges>
+	auto as_tuples(Edges const& edges) -> std::vector<std::tuple<int, int, int>> {
+		auto result = std::vector<std::tuple<int, int, int>>{};
+		for (auto const& e : edges) {
+			result.emplace_back(e.from, e.to, e.weight);
+		}
+		return result;
+	}
+} // namespace
+
+// the same seed gives the same stream, whatever the number of threads
+TEST_CASE("generators are deterministic by seed") {
+	namespace generate = gdwg::generate;
+	auto const params = generate::rmat_parameters{.scale = 12, .edge_factor = 10, .seed = 42};
+	auto const one = generate::rmat<int, int>(params, 100, {.threads = 1});
+	auto const four = generate::rmat<int, int>(params, 100, {.threads = 4});
+	CHECK(one.size() == 40960);
+	CHECK(as_tuples(one) == as_tuples(four));
+	auto other = params;
+	other.seed = 43;
+	CHECK(as_tuples(generate::rmat<int, int>(other)) != as_tuples(one));
+
+	CHECK(as_tuples(generate::erdos_renyi<int, int>(3000, 0.01, 1, 10, {.threads = 1}))
+	      == as_tuples(generate::erdos_renyi<int, int>(3000, 0.01, 1, 10, {.threads = 3})));
+	CHECK(as_tuples(generate::grid<int, int>(300, 100, 1, 10, {.threads = 1}))
+	      == as_tuples(generate::grid<int, int>(300, 100, 1, 10, {.threads = 2})));
+	CHECK(as_tuples(generate::barabasi_albert<int, int>(500, 3, 9))
+	      == as_tuples(generate::barabasi_albert<int, int>(500, 3, 9)));
+}
+
+// shapes of the generated graphs
+TEST_CASE("generator shapes") {
+	namespace generate = gdwg::generate;
+	SECTION("rmat ids and weights stay in range, the degrees are skewed") {
+		auto const edges = generate::rmat<int, int>({.scale = 10, .edge_factor = 16}, 5);
+		auto out_degree = std::map<int, std::size_t>{};
+		for (auto const& e : edges) {
+			REQUIRE((0 <= e.from and e.from < 1024 and 0 <= e.to and e.to < 1024));
+			REQUIRE((1 <= e.weight and e.weight <= 5));
+			++out_degree[e.from];
+		}
+		auto const by_degree = [](auto a, auto b) { return a.second < b.second; };
+		auto const max_degree =
+		   std::max_element(out_degree.begin(), out_degree.end(), by_degree)->second;
+		CHECK(max_degree > 10 * 16);
+	}
+	SECTION("erdos_renyi has no self loop and about p * n * (n - 1) edges") {
+		auto const edges = generate::erdos_renyi<int, double>(2000, 0.005, 7, 2.0);
+		CHECK(std::none_of(edges.begin(), edges.end(), [](auto const& e) { return e.from == e.to; }));
+		CHECK(edges.size() > 18000);
+		CHECK(edges.size() < 22000);
+		CHECK(generate::erdos_renyi<int, int>(5, 1.0, 7).size() == 20);
+		CHECK(generate::erdos_renyi<int, int>(5, 0.0, 7).empty());
+		// the geometric jumps are huge, and must not wrap around
+		CHECK(generate::erdos_renyi<int, int>(100, 1e-300, 7).empty());
+	}
+	SECTION("barabasi_albert adds m undirected edges per node") {
+		auto const edges = generate::barabasi_albert<int, int>(200, 2, 3);
+		auto const g = gdwg::graph<int, int>(edges.begin(), edges.end());
+		CHECK(edges.size() == 2 * (3 + 197 * 2));
+		CHECK(g.nodes().size() == 200);
+		CHECK(g.connections(199).size() == 2);
+	}
+	SECTION("grid links every node to its four neighbours") {
+		auto const edges = generate::grid<int, int>(3, 4, 1);
+		CHECK(edges.size() == 2 * (3 * 3 + 2 * 4));
+		auto const g = gdwg::graph<int, int>(edges.begin(), edges.end());
+		CHECK(g.connections(5) == std::vector<int>{1, 4, 6, 9});
+		CHECK(g.weights(5, 6) == g.weights(6, 5));
+	}
+	SECTION("invalid parameters") {
+		CHECK_THROWS_AS((generate::erdos_renyi<int, int>(5, 1.5, 7)), std::invalid_argument);
+		CHECK_THROWS_AS((generate::barabasi_albert<int, int>(3, 3, 7)), std::invalid_argument);
+		CHECK_THROWS_AS((generate::grid<int, int>(3, 3, 7, 0)), std::invalid_argument);
+		CHECK_THROWS_AS((generate::rmat<int, int>({.scale = 40})), std::invalid_argument);
+	}
+}
@@ -0,0 +1,189 @@
+#include "gdwg/graph.hpp"
+#include "gdwg/k_shortest_paths.hpp"
+#include <algorithm>
+#include <catch2/catch.hpp>
+#include <cstddef>
+#include <random>
+#include <set>
+#include <string>
+#include <vector>
+
+//-------------------------------------------------------------------------------------------------
+//                                test k_shortest_paths
+//-------------------------------------------------------------------------------------------------
+
+namespace {
+	template<typename N, typename E>
+	auto cost(std::vector<typename gdwg::graph<N, E>::iterator> const& path) -> E {
+		auto result = E{};
+		for (auto const& it : path) {
+			auto const& [from, to, weight] = *it;
+			result += weight;
+		}
+		return result;
+	}
+
+	// src, then the dst of every edge
+	template<typename N, typename E>
+	auto nodes_of(N const& src, std::vector<typename gdwg::graph<N, E>::iterator> const& path)
+	   -> std::vector<N> {
+		auto result = std::vector<N>{src};
+		for (auto const& it : path) {
+			auto const& [from, to, weight] = *it;
+			REQUIRE(from == result.back());
+			result.push_back(to);
+		}
+		return result;
+	}
+} // namespace
+
+// auto k_shortest_paths(graph<N, E> const& g, N const& src, N const& dst, std::size_t k,
+//                       std::size_t threads = 0)
+//    -> std::vector<std::vector<typename graph<N, E>::iterator>>;
+TEST_CASE("k shortest paths of a small road network") {
+	using graph = gdwg::graph<std::string, int>;
+	auto g = graph{"C", "D", "E", "F", "G", "H"};
+	g.insert_edge("C", "D", 3);
+	g.insert_edge("C", "E", 2);
+	g.insert_edge("D", "F", 4);
+	g.insert_edge("E", "D", 1);
+	g.insert_edge("E", "F", 2);
+	g.insert_edge("E", "G", 3);
+	g.insert_edge("F", "G", 2);
+	g.insert_edge("F", "H", 1);
+	g.insert_edge("G", "H", 2);
+
+	auto const paths = gdwg::k_shortest_paths(g, std::string("C"), std::string("H"), 3);
+	REQUIRE(paths.size() == 3);
+	CHECK(nodes_of<std::string, int>("C", paths[0]) == std::vector<std::string>{"C", "E", "F", "H"});
+	CHECK(cost<std::string, int>(paths[0]) == 5);
+	CHECK(cost<std::string, int>(paths[1]) == 7);
+	CHECK(cost<std::string, int>(paths[2]) == 8);
+	CHECK(paths[0].front() == g.find("C", "E", 2));
+
+	// only 7 simple paths exist
+	CHECK(gdwg::k_shortest_paths(g, std::string("C"), std::string("H"), 20).size() == 7);
+	CHECK(gdwg::k_shortest_paths(g, std::string("C"), std::string("H"), 0).empty());
+	CHECK(gdwg::k_shortest_paths(g, std::string("H"), std::string("C"), 3).empty());
+	auto const itself = gdwg::k_shortest_paths(g, std::string("C"), std::string("C"), 3);
+	REQUIRE(itself.size() == 1);
+	CHECK(itself[0].empty());
+
+	CHECK_THROWS_WITH(gdwg::k_shortest_paths(g, std::string("C"), std::string("Z"), 3),
+	                  "Cannot call gdwg::k_shortest_paths if src or dst doesn't exist in the graph");
+	g.insert_edge("H", "C", -1);
+	CHECK_THROWS_WITH(gdwg::k_shortest_paths(g, std::string("C"), std::string("H"), 3),
+	                  "Cannot call gdwg::k_shortest_paths on a graph with negative weights");
+}
+
+TEST_CASE("parallel edges make distinct paths") {
+	auto g = gdwg::graph<int, int>{1, 2};
+	g.insert_edge(1, 2, 4);
+	g.insert_edge(1, 2, 1);
+	g.insert_edge(1, 2, 2);
+	auto const paths = gdwg::k_shortest_paths(g, 1, 2, 5);
+	REQUIRE(paths.size() == 3);
+	CHECK(cost<int, int>(paths[0]) == 1);
+	CHECK(cost<int, int>(paths[1]) == 2);
+	CHECK(cost<int, int>(paths[2]) == 4);
+}
+
+// random graphs against every simple path enumerated by a depth first search. The graph of 5000
+// nodes runs the spur searches on several threads
+TEST_CASE("k shortest paths match an enumeration of all simple paths") {
+	auto engine = std::mt19937(6771);
+	for (auto round = 0; round < 10; ++round) {
+		auto const n = 9;
+		auto g = gdwg::graph<int, int>{};
+		for (auto i = 0; i < n; ++i) {
+			g.insert_node(i);
+		}
+		auto pick = std::uniform_int_distribution<int>(0, n - 1);
+		auto weight = std::uniform_int_distribution<int>(0, 9);
+		for (auto i = 0; i < 22; ++i) {
+			g.insert_edge(pick(engine), pick(engine), weight(engine));
+		}
+
+		// the cost of every simple path from 0 to n - 1
+		auto costs = std::vector<int>{};
+		auto on_path = std::vector<bool>(n, false);
+		auto const walk = [&](auto const& self, int u, int so_far) -> void {
+			if (u == n - 1) {
+				costs.push_back(so_far);
+				return;
+			}
+			on_path[static_cast<std::size_t>(u)] = true;
+			for (auto const v : g.connections(u)) {
+				if (not on_path[static_cast<std::size_t>(v)]) {
+					for (auto const w : g.weights(u, v)) {
+						self(self, v, so_far + w);
+					}
+				}
+			}
+			on_path[static_cast<std::size_t>(u)] = false;
+		};
+		walk(walk, 0, 0);
+		std::sort(costs.begin(), costs.end());
+
+		auto const paths = gdwg::k_shortest_paths(g, 0, n - 1, 12);
+		REQUIRE(paths.size() == std::min(costs.size(), std::size_t{12}));
+		for (auto i = std::size_t{0}; i < paths.size(); ++i) {
+			REQUIRE(cost<int, int>(paths[i]) == costs[i]);
+			auto const nodes = nodes_of<int, int>(0, paths[i]);
+			REQUIRE(nodes.back() == n - 1);
+			REQUIRE(std::set<int>(nodes.begin(), nodes.end()).size() == nodes.size());
+		}
+	}
+
+	auto const n = 5000;
+	auto g = gdwg::graph<int, int>{};
+	for (auto i = 0; i < n; ++i) {
+		g.insert_node(i);
+	}
+	auto pick = std::uniform_int_distribution<int>(0, n - 1);
+	auto weight = std::uniform_int_distribution<int>(1, 100);
+	for (auto i = 0; i < 4 * n; ++i) {
+		g.insert_edge(pick(engine), pick(engine), weight(engine));
+	}
+	auto const parallel = gdwg::k_shortest_paths(g, 0, 1, 10, 4);
+	auto const sequential = gdwg::k_shortest_paths(g, 0, 1, 10, 1);
+	REQUIRE(parallel.size() == sequential.size());
+	for (auto i = std::size_t{0}; i < parallel.size(); ++i) {
+		CHECK(parallel[i] == sequential[i]);
+		if (i > 0) {
+			CHECK(cost<int, int>(parallel[i - 1]) <= cost<int, int>(parallel[i]));
+		}
+	}
+}
+
+// k_shortest_paths_finder(graph<N, E> const& g, std::size_t threads = 0);
+// auto paths(N const& src, N const& dst, std::size_t k) const
+//    -> std::vector<std::vector<iterator>>;
+TEST_CASE("a finder answers every query like k_shortest_paths") {
+	auto engine = std::mt19937(6771);
+	auto const n = 12;
+	auto g = gdwg::graph<int, int>{};
+	for (auto i = 0; i < n; ++i) {
+		g.insert_node(i);
+	}
+	auto pick = std::uniform_int_distribution<int>(0, n - 1);
+	auto weight = std::uniform_int_distribution<int>(0, 9);
+	for (auto i = 0; i < 40; ++i) {
+		g.insert_edge(pick(engine), pick(engine), weight(engine));
+	}
+
+	auto const finder = gdwg::k_shortest_paths_finder<int, int>(g);
+	for (auto src = 0; src < n; ++src) {
+		for (auto dst = 0; dst < n; ++dst) {
+			REQUIRE(finder.paths(src, dst, 6) == gdwg::k_shortest_paths(g, src, dst, 6));
+		}
+	}
+
+	CHECK_THROWS_WITH(finder.paths(0, n, 3),
+	                  "Cannot call gdwg::k_shortest_paths_finder<N, E>::paths if src or dst doesn't "
+	                  "exist in the graph");
+	g.insert_edge(0, 1, -1);
+	CHECK_THROWS_WITH((gdwg::k_shortest_paths_finder<int, int>(g)),
+	                  "Cannot create gdwg::k_shortest_paths_finder<N, E> from a graph with negative "
+	                  "weights");
+}
@@ -0,0 +1,88 @@
+#include "gdwg/graph.hpp"
+#include "gdwg/kruskal_reconstruction_tree.hpp"
+#include <catch2/catch.hpp>
+#include <cstddef>
+#include <optional>
+#include <random>
+#include <string>
+#include <vector>
+
+//-------------------------------------------------------------------------------------------------
+//                                test kruskal_reconstruction_tree
+//-------------------------------------------------------------------------------------------------
+
+// explicit kruskal_reconstruction_tree(graph<N, E> const& g);
+// [[nodiscard]] auto connected_with_max_weight(N const& a, N const& b, E const& max_weight)
+//    -> bool;
+// [[nodiscard]] auto bottleneck(N const& a, N const& b) const -> std::optional<E>;
+TEST_CASE("kruskal reconstruction tree answers bottleneck queries") {
+	auto g = gdwg::graph<std::string, int>{"a", "b", "c", "d", "e"};
+	g.insert_edge("a", "b", 4);
+	g.insert_edge("b", "c", 2);
+	g.insert_edge("c", "a", 9);
+	// used against its direction
+	g.insert_edge("d", "c", 6);
+	g.insert_edge("d", "c", 1);
+
+	auto const tree = gdwg::kruskal_reconstruction_tree(g);
+	CHECK(tree.bottleneck("a", "c") == 4);
+	CHECK(tree.bottleneck("c", "d") == 1);
+	CHECK(tree.bottleneck("a", "d") == 4);
+	CHECK(tree.bottleneck("a", "e") == std::nullopt);
+	CHECK(tree.bottleneck("a", "a") == std::nullopt);
+
+	CHECK(tree.connected_with_max_weight("a", "d", 4));
+	CHECK_FALSE(tree.connected_with_max_weight("a", "d", 3));
+	CHECK(tree.connected_with_max_weight("c", "b", 2));
+	CHECK(tree.connected_with_max_weight("e", "e", -100));
+	CHECK_FALSE(tree.connected_with_max_weight("a", "e", 100));
+
+	CHECK_THROWS_WITH(tree.bottleneck("a", "z"),
+	                  "Cannot call gdwg::kruskal_reconstruction_tree<N, E>::bottleneck on a node "
+	                  "that doesn't exist in the graph");
+	CHECK_THROWS_WITH(tree.connected_with_max_weight("z", "a", 1),
+	                  "Cannot call gdwg::kruskal_reconstruction_tree<N, E>::"
+	                  "connected_with_max_weight on a node that doesn't exist in the graph");
+}
+
+// random graphs against a search over the edges <= max_weight in both directions
+TEST_CASE("kruskal reconstruction tree matches a search") {
+	auto engine = std::mt19937(6771);
+	auto const n = 60;
+	auto pick = std::uniform_int_distribution<int>(0, n - 1);
+	auto weight = std::uniform_int_distribution<int>(0, 30);
+	for (auto round = 0; round < 5; ++round) {
+		auto g = gdwg::graph<int, int>{};
+		for (auto i = 0; i < n; ++i) {
+			g.insert_node(i);
+		}
+		for (auto i = 0; i < 70; ++i) {
+			g.insert_edge(pick(engine), pick(engine), weight(engine));
+		}
+		auto const tree = gdwg::kruskal_reconstruction_tree(g);
+		for (auto i = 0; i < 200; ++i) {
+			auto const a = pick(engine);
+			auto const b = pick(engine);
+			auto const max_weight = weight(engine);
+			auto seen = std::vector<bool>(n, false);
+			auto stack = std::vector<int>{a};
+			seen[static_cast<std::size_t>(a)] = true;
+			while (not stack.empty()) {
+				auto const u = stack.back();
+				stack.pop_back();
+				for (auto const& [from, to, w] : g) {
+					if (w > max_weight or (from != u and to != u)) {
+						continue;
+					}
+					auto const v = from == u ? to : from;
+					if (not seen[static_cast<std::size_t>(v)]) {
+						seen[static_cast<std::size_t>(v)] = true;
+						stack.push_back(v);
+					}
+				}
+			}
+			auto const reached = bool{seen[static_cast<std::size_t>(b)]};
+			REQUIRE(tree.connected_with_max_weight(a, b, max_weight) == reached);
+		}
+	}
+}
@@ -0,0 +1,128 @@
+#include "gdwg/graph.hpp"
+#include "gdwg/latency.hpp"
+#include <algorithm>
+#include <catch2/catch.hpp>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+//-------------------------------------------------------------------------------------------------
+//              test the latency histograms, built with GDWG_ENABLE_LATENCY
+//-------------------------------------------------------------------------------------------------
+
+#ifndef GDWG_ENABLE_LATENCY
+#error "graph_test_latency must be built with GDWG_ENABLE_LATENCY"
+#endif
+
+namespace {
+	auto count_of(std::vector<gdwg::latency::operation_latency> const& report, std::string_view name)
+	   -> std::uint64_t {
+		auto const it = std::find_if(report.begin(), report.end(), [name](auto const& entry) {
+			return entry.operation == name;
+		});
+		return it == report.end() ? 0 : it->latency.count();
+	}
+} // namespace
+
+// every value is in a bucket whose upper bound is within 1/16 of it
+TEST_CASE("latency histogram") {
+	using gdwg::latency::histogram;
+	for (auto value = std::uint64_t{0}; value < 100'000; value += 7) {
+		auto const bucket = histogram::bucket_of(value);
+		REQUIRE(bucket < histogram::num_buckets);
+		REQUIRE(histogram::highest_in(bucket) >= value);
+		REQUIRE(histogram::highest_in(bucket) - value <= value / histogram::sub_buckets);
+	}
+	CHECK(histogram::bucket_of(std::uint64_t{1} << 50U) == histogram::num_buckets - 1);
+
+	auto h = histogram{};
+	CHECK(h.percentile(0.5) == 0);
+	for (auto value = std::uint64_t{1}; value <= 1000; ++value) {
+		h.record(value);
+	}
+	CHECK(h.count() == 1000);
+	CHECK(h.min() == 1);
+	CHECK(h.max() == 1000);
+	CHECK(h.mean() == Approx(500.5));
+	CHECK(h.percentile(0.5) >= 500);
+	CHECK(h.percentile(0.5) <= 500 + 500 / 16);
+	CHECK(h.percentile(0.99) >= 990);
+	CHECK(h.percentile(1.0) == 1000);
+	CHECK(h.percentile(0.0) == 1);
+
+	auto other = histogram{};
+	other.record(5000);
+	h.merge(other);
+	CHECK(h.count() == 1001);
+	CHECK(h.max() == 5000);
+}
+
+// public members record, nested public calls don't, threads are merged
+TEST_CASE("graph operations are recorded") {
+	gdwg::latency::reset();
+	auto g = gdwg::graph<int, int>{};
+	g.insert_node(1);
+	g.insert_node(2);
+	g.insert_edge(1, 2, 3);
+	CHECK(g.connections(1) == std::vector<int>{2});
+	CHECK(g.weights(1, 2) == std::vector<int>{3});
+
+	auto report = gdwg::latency::snapshot();
+	CHECK(count_of(report, "insert_node") == 2);
+	CHECK(count_of(report, "insert_edge") == 1);
+	CHECK(count_of(report, "connections") == 1);
+	CHECK(count_of(report, "weights") == 1);
+	// called by insert_node and insert_edge only
+	CHECK(count_of(report, "is_node") == 0);
+
+	SECTION("threads") {
+		auto workers = std::vector<std::thread>{};
+		for (auto t = 0; t < 4; ++t) {
+			workers.emplace_back([&g] {
+				for (auto i = 0; i < 100; ++i) {
+					static_cast<void>(g.is_connected(1, 2));
+				}
+			});
+		}
+		for (auto& worker : workers) {
+			worker.join();
+		}
+		CHECK(count_of(gdwg::latency::snapshot(), "is_connected") == 400);
+	}
+	SECTION("the recorders of exited threads are released, their latencies kept") {
+		auto const live = [] {
+			auto& r = gdwg::latency::detail::global();
+			auto const lock = std::lock_guard(r.mutex);
+			return r.live.size();
+		};
+		auto const before = live();
+		for (auto t = 0; t < 50; ++t) {
+			std::thread([&g] { static_cast<void>(g.is_connected(1, 2)); }).join();
+		}
+		CHECK(live() == before);
+		CHECK(count_of(gdwg::latency::snapshot(), "is_connected") == 50);
+		gdwg::latency::reset();
+		CHECK(count_of(gdwg::latency::snapshot(), "is_connected") == 0);
+	}
+	SECTION("export") {
+		auto const text = gdwg::latency::to_text(report);
+		CHECK(text.starts_with("operation"));
+		CHECK(text.find("\nweights ") != std::string::npos);
+		auto const json = gdwg::latency::to_json(report);
+		CHECK(json.starts_with(R"({"insert_node":{"count":2,"min_ns":)"));
+		CHECK(json.find(R"("weights":{"count":1,)") != std::string::npos);
+		CHECK(json.ends_with("}}"));
+		CHECK(gdwg::latency::to_json({}) == "{}");
+	}
+	SECTION("reset and disable") {
+		gdwg::latency::reset();
+		CHECK(gdwg::latency::snapshot().empty());
+		gdwg::latency::set_enabled(false);
+		static_cast<void>(g.weights(1, 2));
+		CHECK(gdwg::latency::snapshot().empty());
+		gdwg::latency::set_enabled(true);
+		static_cast<void>(g.weights(1, 2));
+		CHECK(count_of(gdwg::latency::snapshot(), "weights") == 1);
+	}
+}
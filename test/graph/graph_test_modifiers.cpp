@@ -1,5 +1,7 @@
 #include "gdwg/graph.hpp"
 #include <catch2/catch.hpp>
+#include <map>
+#include <utility>
 #include <vector>
 
 //-------------------------------------------------------------------------------------------------
@@ -75,6 +77,80 @@ TEST_CASE("insert edge") {
 	}
 }
 
+// payload counting its copies, to check that the rvalue and emplace overloads never copy
+struct counted {
+	counted() = default;
+	explicit counted(std::string v)
+	: value{std::move(v)} {}
+	counted(counted const& other)
+	: value{other.value} {
+		++copies;
+	}
+	counted(counted&&) noexcept = default;
+	auto operator=(counted const& other) -> counted& {
+		value = other.value;
+		++copies;
+		return *this;
+	}
+	auto operator=(counted&&) noexcept -> counted& = default;
+	~counted() = default;
+	auto operator<=>(counted const&) const = default;
+
+	std::string value;
+	static inline int copies = 0;
+};
+
+// auto insert_node(N&& value) -> bool;
+// auto emplace_node(Args&&... args) -> bool;
+// auto insert_edge(N const& src, N const& dst, E&& weight) -> bool;
+// auto emplace_edge(N const& src, N const& dst, Args&&... args) -> bool;
+// auto try_insert_edge(N const& src, N const& dst, E weight) -> std::pair<iterator, bool>;
+// construct nodes and weights in place, without copying them
+TEST_CASE("move-aware insertion") {
+	SECTION("nodes are never copied") {
+		auto g = gdwg::graph<counted, int>{};
+		counted::copies = 0;
+		CHECK(g.insert_node(counted("sydney")));
+		CHECK(g.emplace_node("perth"));
+		CHECK(not g.emplace_node("perth"));
+		auto node = counted("sydney");
+		CHECK(not g.insert_node(std::move(node)));
+		CHECK(g.insert_edge(counted("sydney"), counted("perth"), 1));
+		CHECK(g.replace_node(counted("perth"), counted("darwin")));
+		CHECK(g.erase_edge(counted("sydney"), counted("darwin"), 1));
+		CHECK(g.erase_node(counted("darwin")));
+		CHECK(counted::copies == 0);
+	}
+	// the first weight is copied into the weight limits, which only change on a new extreme
+	SECTION("weights are never copied") {
+		auto g = gdwg::graph<int, counted>{1, 2};
+		CHECK(g.insert_edge(1, 2, counted("a")));
+		CHECK(g.insert_edge(1, 2, counted("z")));
+		counted::copies = 0;
+		CHECK(g.insert_edge(1, 2, counted("plane")));
+		CHECK(g.emplace_edge(1, 2, "train"));
+		CHECK(not g.emplace_edge(1, 2, "train"));
+		CHECK(counted::copies == 0);
+		auto const expected =
+		   std::vector<counted>{counted("a"), counted("plane"), counted("train"), counted("z")};
+		CHECK(g.weights(1, 2) == expected);
+	}
+	SECTION("try_insert_edge returns the edge, inserted or not") {
+		auto g = gdwg::graph<int, std::string>{1, 2};
+		auto const [it, inserted] = g.try_insert_edge(1, 2, "cat");
+		CHECK(inserted);
+		CHECK(*it == ranges::common_tuple<int, int, std::string>{1, 2, "cat"});
+		auto const [it2, inserted2] = g.try_insert_edge(1, 2, "cat");
+		CHECK(not inserted2);
+		CHECK(it2 == it);
+		CHECK_THROWS_MATCHES(g.try_insert_edge(1, 3, "cat"),
+		                     std::runtime_error,
+		                     Catch::Matchers::Message("Cannot call gdwg::graph<N, E>::"
+		                                              "try_insert_edge when either src or dst node "
+		                                              "does not exist"));
+	}
+}
+
 // auto replace_node(N const& old_data, N const& new_data) -> bool;
 // replace node if old_data exist and new_data doesn't exist
 // return true if the replacement is successful
@@ -228,6 +304,70 @@ TEST_CASE("erase node") {
 	}
 }
 
+// auto erase_nodes(I first, S last) -> std::size_t;
+// auto erase_nodes(R const& values) -> std::size_t;
+// same result as erase_node for each value, non-existing values are ignored
+// return the number of erased nodes
+TEST_CASE("erase nodes") {
+	auto g = gdwg::graph<int, std::string>{1, 2, 3, 4};
+	g.insert_edge(1, 1, "pig");
+	g.insert_edge(1, 2, "cat");
+	g.insert_edge(2, 3, "ox");
+	g.insert_edge(3, 4, "sheep");
+	g.insert_edge(4, 2, "monkey");
+
+	auto expected_result = gdwg::graph<int, std::string>{2, 4};
+	expected_result.insert_edge(4, 2, "monkey");
+
+	CHECK(g.erase_nodes(std::vector<int>{3, 1, 7, 3}) == 2);
+	CHECK(g == expected_result);
+	auto const none = std::vector<int>{5, 6};
+	CHECK(g.erase_nodes(none.begin(), none.end()) == 0);
+	CHECK(g == expected_result);
+}
+
+// auto merge_replace_nodes(R const& mapping) -> void;
+// same result as merge_replace_node for each (old, new) pair, duplicate edges are merged
+TEST_CASE("merge replace nodes") {
+	auto g = gdwg::graph<int, std::string>{1, 2, 3, 4, 5};
+	g.insert_edge(1, 2, "cat");
+	g.insert_edge(3, 2, "cat");
+	g.insert_edge(2, 4, "dog");
+	g.insert_edge(4, 4, "ox");
+	g.insert_edge(5, 1, "pig");
+
+	SECTION("successful merge") {
+		auto expected_result = gdwg::graph<int, std::string>{2, 5};
+		expected_result.insert_edge(5, 5, "pig");
+		expected_result.insert_edge(5, 2, "cat");
+		expected_result.insert_edge(2, 2, "dog");
+		expected_result.insert_edge(2, 2, "ox");
+
+		g.merge_replace_nodes(std::map<int, int>{{1, 5}, {3, 5}, {4, 2}, {2, 2}});
+		CHECK(g == expected_result);
+	}
+	// invalid mappings are rejected before the graph changes
+	SECTION("exceptions") {
+		auto const copy = g;
+		CHECK_THROWS_MATCHES(g.merge_replace_nodes(std::vector<std::pair<int, int>>{{1, 2}, {9, 2}}),
+		                     std::runtime_error,
+		                     Catch::Matchers::Message("Cannot call gdwg::graph<N, E>::"
+		                                              "merge_replace_nodes on old or new data if "
+		                                              "they don't exist in the graph"));
+		CHECK_THROWS_MATCHES(g.merge_replace_nodes(std::vector<std::pair<int, int>>{{1, 2}, {2, 3}}),
+		                     std::runtime_error,
+		                     Catch::Matchers::Message("Cannot call gdwg::graph<N, E>::"
+		                                              "merge_replace_nodes when a new node is also "
+		                                              "replaced"));
+		CHECK_THROWS_MATCHES(g.merge_replace_nodes(std::vector<std::pair<int, int>>{{1, 2}, {1, 3}}),
+		                     std::runtime_error,
+		                     Catch::Matchers::Message("Cannot call gdwg::graph<N, E>::"
+		                                              "merge_replace_nodes when a node is replaced "
+		                                              "by more than one node"));
+		CHECK(g == copy);
+	}
+}
+
 // auto erase_edge(N const& src, N const& dst, E const& weight) -> bool;
 // erase edge by value
 // if the edge exist, erase it and return true
@@ -339,6 +479,120 @@ TEST_CASE("erase edge by iterator range") {
 	CHECK(g == expected_result);
 }
 
+// auto erase_edges_with_weight_below(E const& threshold) -> std::size_t;
+// prune every edge lighter than threshold, the weight index follows the other modifiers
+TEST_CASE("erase edges with weight below") {
+	auto g = gdwg::graph<int, int>{1, 2, 3};
+	g.insert_edge(1, 2, 5);
+	g.insert_edge(1, 3, 1);
+	g.insert_edge(2, 1, 3);
+	g.insert_edge(3, 3, 7);
+	CHECK(g.count_edges_with_weight_in(0, 10) == 4);
+
+	g.insert_edge(2, 3, 2);
+	g.update_weight(g.find(3, 3, 7), 0);
+	CHECK(g.erase_edges_with_weight_below(3) == 3);
+	CHECK(g.count_edges_with_weight_in(0, 10) == 2);
+	CHECK(g.weights(1, 2) == std::vector<int>{5});
+	CHECK(g.weights(2, 1) == std::vector<int>{3});
+	CHECK(not g.is_connected(2, 3));
+	CHECK(not g.is_connected(3, 3));
+	CHECK(g.erase_edges_with_weight_below(3) == 0);
+	g.erase_node(1);
+	CHECK(g.erase_edges_with_weight_below(100) == 0);
+	CHECK(g.begin() == g.end());
+}
+
+// auto insert_edges(R const& values) -> std::size_t;
+// auto erase_edges(R const& values) -> std::size_t;
+// batch insertion and erasure of edges, in any order, existing or not; the caches and indexes
+// follow
+TEST_CASE("insert and erase edges in batch") {
+	using graph = gdwg::graph<int, int>;
+	auto g = graph{1, 2, 3, 4};
+	g.enable_query_cache(8);
+	g.insert_edge(2, 3, 4);
+	CHECK(g.weights(1, 2).empty());
+	CHECK(g.count_edges_with_weight_in(0, 10) == 1);
+
+	auto const edges = std::vector<graph::value_type>{
+	   {1, 2, 1},
+	   {1, 2, 5},
+	   {1, 4, 2},
+	   {2, 3, 4},
+	   {3, 1, 9},
+	   {4, 4, 0},
+	   {1, 3, 7},
+	};
+	CHECK(g.insert_edges(edges) == 6);
+	CHECK(g.insert_edges(edges) == 0);
+	CHECK(g.weights(1, 2) == std::vector<int>{1, 5});
+	CHECK(g.connections(1) == std::vector<int>{2, 3, 4});
+	CHECK(g.count_edges_with_weight_in(0, 10) == 7);
+	CHECK(g == graph(edges.begin(), edges.end()));
+
+	auto const erased = std::vector<graph::value_type>{
+	   {1, 2, 1},
+	   {1, 2, 3},
+	   {1, 4, 2},
+	   {4, 4, 0},
+	   {2, 3, 4},
+	};
+	CHECK(g.erase_edges(erased) == 4);
+	CHECK(g.erase_edges(erased) == 0);
+	CHECK(g.weights(1, 2) == std::vector<int>{5});
+	CHECK(g.connections(1) == std::vector<int>{2, 3});
+	CHECK(not g.is_connected(4, 4));
+	CHECK(g.count_edges_with_weight_in(0, 10) == 3);
+
+	auto const missing = std::vector<graph::value_type>{{1, 2, 5}, {1, 9, 1}};
+	CHECK_THROWS_WITH(g.erase_edges(missing),
+	                  "Cannot call gdwg::graph<N, E>::erase_edges on src or dst if they don't exist "
+	                  "in the graph");
+	CHECK_THROWS_WITH(g.insert_edges(missing),
+	                  "Cannot call gdwg::graph<N, E>::insert_edges when either src or dst node does "
+	                  "not exist");
+	CHECK(g.weights(1, 2) == std::vector<int>{5});
+}
+
+// auto update_weight(iterator i, E const& new_weight) -> iterator;
+// auto update_weight(N const& src, N const& dst, E const& old_weight, E const& new_weight) -> bool;
+// change the weight of an existing edge without erasing and re-inserting it
+TEST_CASE("update weight") {
+	auto g = gdwg::graph<int, int>{1, 2, 3};
+	g.insert_edge(1, 2, 5);
+	g.insert_edge(1, 2, 8);
+	g.insert_edge(2, 3, 1);
+
+	SECTION("by iterator: the edge moves to its new position") {
+		auto it = g.update_weight(g.find(1, 2, 5), 9);
+		CHECK(*it == ranges::common_tuple<int, int, int>{1, 2, 9});
+		CHECK(g.weights(1, 2) == std::vector<int>{8, 9});
+		CHECK(std::next(it) == g.find(2, 3, 1));
+	}
+	SECTION("weights outside the old limits are still found") {
+		CHECK(g.update_weight(2, 3, 1, -100));
+		CHECK(g.is_connected(2, 3));
+		CHECK(g.weights(2, 3) == std::vector<int>{-100});
+		CHECK(g.update_weight(2, 3, -100, 100));
+		CHECK(g.is_connected(2, 3));
+		CHECK(g.find(2, 3, 100) != g.end());
+	}
+	SECTION("updating to an existing weight merges the two edges") {
+		auto it = g.update_weight(g.find(1, 2, 5), 8);
+		CHECK(*it == ranges::common_tuple<int, int, int>{1, 2, 8});
+		CHECK(g.weights(1, 2) == std::vector<int>{8});
+	}
+	SECTION("missing edge and exception") {
+		CHECK(not g.update_weight(1, 3, 5, 6));
+		auto const message = std::string("Cannot call gdwg::graph<N, E>::update_weight on src or dst "
+		                                 "if they don't exist in the graph");
+		CHECK_THROWS_MATCHES(g.update_weight(1, 4, 5, 6),
+		                     std::runtime_error,
+		                     Catch::Matchers::Message(message));
+	}
+}
+
 // auto clear() noexcept -> void;
 // clear all nodes and edges of the graph
 TEST_CASE("clear graph") {
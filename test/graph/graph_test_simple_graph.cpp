@@ -0,0 +1,136 @@
+#include "gdwg/simple_graph.hpp"
+#include <catch2/catch.hpp>
+#include <optional>
+#include <sstream>
+#include <string>
+#include <tuple>
+#include <vector>
+
+//-------------------------------------------------------------------------------------------------
+//          test simple_graph: at most one edge per (src, dst), weighted or unweighted
+//-------------------------------------------------------------------------------------------------
+
+static_assert(ranges::bidirectional_iterator<gdwg::simple_graph<int, int>::iterator>);
+static_assert(ranges::bidirectional_iterator<gdwg::unweighted_graph<int>::iterator>);
+static_assert(ranges::bidirectional_range<gdwg::unweighted_graph<int> const>);
+
+// the weighted members don't exist without a weight
+template<typename G>
+concept weighted_members = requires(G g) {
+	g.insert_edge(1, 2, 3);
+	g.update_weight(1, 2, 3);
+	g.weight(1, 2);
+};
+template<typename G>
+concept unweighted_members = requires(G g) { g.insert_edge(1, 2); };
+static_assert(weighted_members<gdwg::simple_graph<int, int>>);
+static_assert(not unweighted_members<gdwg::simple_graph<int, int>>);
+static_assert(not weighted_members<gdwg::unweighted_graph<int>>);
+static_assert(unweighted_members<gdwg::unweighted_graph<int>>);
+
+// all edges of the graph, in iteration order
+template<typename N, typename E>
+auto all_edges(gdwg::simple_graph<N, E> const& g) {
+	auto result = std::vector<typename gdwg::simple_graph<N, E>::iterator::value_type>{};
+	for (auto it = g.begin(); it != g.end(); ++it) {
+		result.emplace_back(*it);
+	}
+	return result;
+}
+
+// a second edge between the same nodes is refused, weight() is the only weight
+TEST_CASE("weighted simple_graph") {
+	using graph = gdwg::simple_graph<std::string, int>;
+	auto const v = std::vector<graph::value_type>{
+	   {"sydney", "perth", 5},
+	   {"sydney", "perth", 3},
+	   {"perth", "darwin", 1},
+	};
+	auto g = graph(v.begin(), v.end());
+	g.insert_node("hobart");
+
+	CHECK(g.nodes() == std::vector<std::string>{"darwin", "hobart", "perth", "sydney"});
+	CHECK(g.num_edges() == 2);
+	CHECK(g.weight("sydney", "perth") == 5);
+	CHECK(g.weight("perth", "sydney") == std::nullopt);
+	CHECK(g.is_connected("perth", "darwin"));
+	CHECK(not g.insert_edge("perth", "darwin", 2));
+	CHECK(g.update_weight("perth", "darwin", 2));
+	CHECK(g.weight("perth", "darwin") == 2);
+	CHECK(not g.update_weight("darwin", "perth", 2));
+	CHECK(g.connections("sydney") == std::vector<std::string>{"perth"});
+
+	using edge = std::tuple<std::string, std::string, int>;
+	CHECK(*g.find("sydney", "perth") == edge{"sydney", "perth", 5});
+	CHECK(g.find("perth", "sydney") == g.end());
+	CHECK(*--g.end() == edge{"sydney", "perth", 5});
+
+	auto out = std::ostringstream{};
+	out << g;
+	CHECK(out.str()
+	      == "darwin (\n)\nhobart (\n)\nperth (\n  darwin | 2\n)\nsydney (\n  perth | 5\n)\n");
+
+	SECTION("exceptions") {
+		CHECK_THROWS_MATCHES(g.insert_edge("sydney", "adelaide", 1),
+		                     std::runtime_error,
+		                     Catch::Matchers::Message("Cannot call gdwg::simple_graph<N, E>::"
+		                                              "insert_edge when either src or dst node does "
+		                                              "not exist"));
+		CHECK_THROWS_MATCHES(g.weight("adelaide", "sydney"),
+		                     std::runtime_error,
+		                     Catch::Matchers::Message("Cannot call gdwg::simple_graph<N, E>::"
+		                                              "weight if src or dst node don't exist in the "
+		                                              "graph"));
+		CHECK_THROWS_AS(g.update_weight("adelaide", "sydney", 1), std::runtime_error);
+		CHECK_THROWS_AS(g.is_connected("adelaide", "sydney"), std::runtime_error);
+		CHECK_THROWS_AS(g.erase_edge("adelaide", "sydney"), std::runtime_error);
+		CHECK_THROWS_AS(g.connections("adelaide"), std::runtime_error);
+	}
+}
+
+// no weights at all: the edges are (src, dst) pairs
+TEST_CASE("unweighted simple_graph") {
+	using edge = std::tuple<int, int>;
+	auto g = gdwg::unweighted_graph<int>{1, 2, 3, 4};
+	CHECK(g.insert_edge(1, 1));
+	CHECK(g.insert_edge(1, 2));
+	CHECK(g.insert_edge(2, 1));
+	CHECK(g.insert_edge(3, 1));
+	CHECK(g.insert_edge(3, 2));
+	CHECK(not g.insert_edge(3, 2));
+	CHECK(g.num_edges() == 5);
+	CHECK(all_edges(g) == std::vector<edge>{{1, 1}, {1, 2}, {2, 1}, {3, 1}, {3, 2}});
+
+	auto out = std::ostringstream{};
+	out << g;
+	CHECK(out.str() == "1 (\n  1\n  2\n)\n2 (\n  1\n)\n3 (\n  1\n  2\n)\n4 (\n)\n");
+
+	SECTION("erase") {
+		CHECK(g.erase_edge(3, 2));
+		CHECK(not g.erase_edge(3, 2));
+		CHECK(g.erase_node(1));
+		CHECK(not g.erase_node(1));
+		CHECK(all_edges(g).empty());
+		CHECK(g.num_edges() == 0);
+	}
+	SECTION("merge replace keeps one edge per pair") {
+		g.merge_replace_node(2, 3);
+		CHECK(all_edges(g) == std::vector<edge>{{1, 1}, {1, 3}, {3, 1}, {3, 3}});
+		CHECK(g.num_edges() == 4);
+		CHECK(not g.is_node(2));
+	}
+	SECTION("replace") {
+		CHECK(g.replace_node(1, 9));
+		CHECK(not g.replace_node(9, 2));
+		CHECK(all_edges(g) == std::vector<edge>{{2, 9}, {3, 2}, {3, 9}, {9, 2}, {9, 9}});
+	}
+	SECTION("comparison and clear") {
+		auto copy = g;
+		CHECK(copy == g);
+		copy.erase_edge(1, 1);
+		CHECK(copy != g);
+		g.clear();
+		CHECK(g.empty());
+		CHECK(g.begin() == g.end());
+	}
+}
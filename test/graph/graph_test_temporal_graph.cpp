@@ -0,0 +1,123 @@
+#include "gdwg/temporal_graph.hpp"
+#include <algorithm>
+#include <catch2/catch.hpp>
+#include <iterator>
+#include <optional>
+#include <random>
+#include <string>
+#include <tuple>
+#include <vector>
+
+//-------------------------------------------------------------------------------------------------
+//                        test the graph with time stamped edges
+//-------------------------------------------------------------------------------------------------
+
+// insert_edge / erase_edge, edges_between(t0, t1) and snapshot_at(t)
+TEST_CASE("temporal_graph time windows") {
+	using graph = gdwg::temporal_graph<std::string, int, int>;
+	using edge = graph::value_type;
+	auto g = graph{"sydney", "perth", "darwin"};
+	CHECK(g.insert_edge("sydney", "perth", 5, 0, 10));
+	CHECK(g.insert_edge("perth", "darwin", 1, 5, 6));
+	CHECK(g.insert_edge("sydney", "perth", 5, 20, 30));
+	CHECK(not g.insert_edge("sydney", "perth", 5, 0, 10));
+	CHECK(g.num_edges() == 3);
+
+	CHECK(g.edges_between(6, 20).size() == 1);
+	CHECK(g.edges_between(5, 6)
+	      == std::vector<edge>{{"sydney", "perth", 5, 0, 10}, {"perth", "darwin", 1, 5, 6}});
+	CHECK(g.edges_between(30, 40).empty());
+	CHECK(g.edges_between(6, 6).empty());
+
+	auto const snapshot = g.snapshot_at(5);
+	CHECK(snapshot.nodes() == std::vector<std::string>{"darwin", "perth", "sydney"});
+	CHECK(snapshot.is_connected("perth", "darwin"));
+	CHECK(snapshot.weights("sydney", "perth") == std::vector<int>{5});
+	CHECK(not g.snapshot_at(6).is_connected("perth", "darwin"));
+	CHECK(not g.snapshot_at(10).is_connected("sydney", "perth"));
+
+	CHECK(g.erase_edge("perth", "darwin", 1, 5, 6));
+	CHECK(not g.erase_edge("perth", "darwin", 1, 5, 6));
+	CHECK(g.edges_between(0, 100).size() == 2);
+
+	SECTION("exceptions") {
+		CHECK_THROWS_MATCHES(g.insert_edge("sydney", "hobart", 1, 0, 1),
+		                     std::runtime_error,
+		                     Catch::Matchers::Message("Cannot call gdwg::temporal_graph<N, E, Time>::"
+		                                              "insert_edge when either src or dst node does "
+		                                              "not exist"));
+		CHECK_THROWS_MATCHES(g.insert_edge("sydney", "perth", 1, 3, 3),
+		                     std::runtime_error,
+		                     Catch::Matchers::Message("Cannot call gdwg::temporal_graph<N, E, Time>::"
+		                                              "insert_edge with an empty validity interval"));
+		CHECK_THROWS_AS(g.erase_edge("hobart", "perth", 1, 0, 1), std::runtime_error);
+		CHECK_THROWS_AS(g.earliest_arrival("hobart", "perth", 0), std::runtime_error);
+	}
+}
+
+// [[nodiscard]] auto earliest_arrival(N const& src, N const& dst, Time const& start)
+// paths have to follow the validity intervals, waiting at a node is allowed
+TEST_CASE("temporal_graph time respecting paths") {
+	using graph = gdwg::temporal_graph<char, int, int>;
+	using edge = graph::value_type;
+	auto g = graph{'a', 'b', 'c', 'd'};
+	g.insert_edge('a', 'b', 1, 0, 2);
+	g.insert_edge('b', 'c', 1, 5, 6);
+	g.insert_edge('a', 'c', 1, 8, 9);
+	g.insert_edge('c', 'd', 1, 0, 4);
+
+	CHECK(g.earliest_arrival('a', 'c', 0) == 5);
+	CHECK(g.time_respecting_path('a', 'c', 0)
+	      == std::vector<edge>{{'a', 'b', 1, 0, 2}, {'b', 'c', 1, 5, 6}});
+	CHECK(g.earliest_arrival('a', 'c', 3) == 8);
+	CHECK(g.earliest_arrival('a', 'c', 9) == std::nullopt);
+	// c -> d closes before c can be reached
+	CHECK(g.earliest_arrival('a', 'd', 0) == std::nullopt);
+	CHECK(g.time_respecting_path('a', 'd', 0) == std::nullopt);
+	CHECK(g.earliest_arrival('d', 'd', 7) == 7);
+	CHECK(g.time_respecting_path('d', 'd', 7) == std::vector<edge>{});
+}
+
+// many more edges than block_capacity, inserted out of order, against a plain vector
+TEST_CASE("temporal_graph blocks match a linear scan") {
+	using graph = gdwg::temporal_graph<int, int, int>;
+	auto g = graph{0, 1, 2, 3, 4, 5, 6, 7};
+	auto all = std::vector<graph::value_type>{};
+	auto engine = std::mt19937(6771);
+	auto node = std::uniform_int_distribution<int>(0, 7);
+	auto time = std::uniform_int_distribution<int>(0, 999);
+	auto length = std::uniform_int_distribution<int>(1, 50);
+	for (auto i = 0; i < 3000; ++i) {
+		auto const begin = i % 4 == 0 ? time(engine) : i / 3;
+		auto const e =
+		   graph::value_type{node(engine), node(engine), i % 5, begin, begin + length(engine)};
+		if (g.insert_edge(e.from, e.to, e.weight, e.begin, e.end)) {
+			all.push_back(e);
+		}
+	}
+	for (auto i = std::size_t{0}; i < all.size(); i += 3) {
+		REQUIRE(g.erase_edge(all[i].from, all[i].to, all[i].weight, all[i].begin, all[i].end));
+	}
+	auto kept = std::vector<graph::value_type>{};
+	for (auto i = std::size_t{0}; i < all.size(); ++i) {
+		if (i % 3 != 0) {
+			kept.push_back(all[i]);
+		}
+	}
+	REQUIRE(g.num_edges() == kept.size());
+
+	for (auto t0 = 0; t0 < 1100; t0 += 37) {
+		auto const t1 = t0 + 25;
+		auto expected = std::vector<graph::value_type>{};
+		std::copy_if(kept.begin(), kept.end(), std::back_inserter(expected), [&](auto const& e) {
+			return e.begin < t1 and t0 < e.end;
+		});
+		auto found = g.edges_between(t0, t1);
+		auto const by_begin = [](auto const& a, auto const& b) {
+			return std::tie(a.begin, a.from, a.to, a.weight, a.end)
+			       < std::tie(b.begin, b.from, b.to, b.weight, b.end);
+		};
+		std::sort(expected.begin(), expected.end(), by_begin);
+		CHECK(found == expected);
+	}
+}
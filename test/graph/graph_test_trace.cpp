@@ -0,0 +1,90 @@
+#include "gdwg/graph.hpp"
+#include "gdwg/trace.hpp"
+#include <algorithm>
+#include <catch2/catch.hpp>
+#include <string>
+#include <string_view>
+#include <vector>
+
+//-------------------------------------------------------------------------------------------------
+//                  test the tracing spans, built with GDWG_ENABLE_TRACE
+//-------------------------------------------------------------------------------------------------
+
+#ifndef GDWG_ENABLE_TRACE
+#error "graph_test_trace must be built with GDWG_ENABLE_TRACE"
+#endif
+
+namespace {
+	auto names(std::vector<gdwg::trace::event> const& events) -> std::vector<std::string_view> {
+		auto result = std::vector<std::string_view>{};
+		for (auto const& e : events) {
+			result.emplace_back(e.name);
+		}
+		return result;
+	}
+} // namespace
+
+// spans are recorded as they end: nested public calls and phases come before the operation
+// they belong to
+TEST_CASE("spans of operations and phases") {
+	auto g = gdwg::graph<int, int>{1, 2, 3};
+	g.insert_edge(1, 2, 5);
+	g.insert_edge(3, 2, 5);
+	gdwg::trace::clear();
+
+	g.merge_replace_node(2, 3);
+	auto const events = gdwg::trace::events();
+	using name_list = std::vector<std::string_view>;
+	CHECK(names(events)
+	      == name_list{"graph::is_node",
+	                   "graph::is_node",
+	                   "lookup",
+	                   "rebalance",
+	                   "rebalance",
+	                   "scan",
+	                   "graph::merge_replace_node"});
+	// the phases are inside the operation, one after the other
+	auto const& operation = events.back();
+	for (auto const& e : events) {
+		CHECK(e.begin_ns >= operation.begin_ns);
+		CHECK(e.begin_ns + e.duration_ns <= operation.begin_ns + operation.duration_ns);
+		CHECK(e.thread == operation.thread);
+	}
+	CHECK(events[5].begin_ns >= events[2].begin_ns + events[2].duration_ns);
+
+	SECTION("insert_edge") {
+		gdwg::trace::clear();
+		g.insert_edge(1, 1, 1);
+		CHECK(names(gdwg::trace::events())
+		      == name_list{"allocation", "lookup", "rebalance", "indexes", "graph::insert_edge"});
+	}
+	SECTION("chrome trace export") {
+		auto const json = gdwg::trace::to_chrome_json();
+		CHECK(json.starts_with(R"({"displayTimeUnit":"ns","traceEvents":[)"
+		                       R"({"name":"graph::is_node","ph":"X",)"));
+		CHECK(json.ends_with("}]}"));
+		CHECK(std::count(json.begin(), json.end(), '{') == 1 + 7);
+		CHECK(gdwg::trace::to_chrome_json({}) == R"({"displayTimeUnit":"ns","traceEvents":[]})");
+	}
+	SECTION("disabled at run time") {
+		gdwg::trace::clear();
+		gdwg::trace::set_enabled(false);
+		g.erase_node(1);
+		gdwg::trace::set_enabled(true);
+		CHECK(gdwg::trace::events().empty());
+	}
+}
+
+// the ring buffer keeps the most recent spans
+TEST_CASE("trace buffer is bounded") {
+	gdwg::trace::clear();
+	auto const g = gdwg::graph<int, int>{1};
+	for (auto i = std::size_t{0}; i < gdwg::trace::buffer_capacity + 10; ++i) {
+		static_cast<void>(g.is_node(1));
+	}
+	auto const events = gdwg::trace::events();
+	CHECK(events.size() == gdwg::trace::buffer_capacity);
+	CHECK(std::is_sorted(events.begin(), events.end(), [](auto const& a, auto const& b) {
+		return a.begin_ns < b.begin_ns;
+	}));
+}
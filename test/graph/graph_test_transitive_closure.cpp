@@ -0,0 +1,107 @@
+#include "gdwg/graph.hpp"
+#include "gdwg/transitive_closure.hpp"
+#include <catch2/catch.hpp>
+#include <cstddef>
+#include <random>
+#include <string>
+#include <vector>
+
+//-------------------------------------------------------------------------------------------------
+//                                test transitive_closure
+//-------------------------------------------------------------------------------------------------
+
+// explicit transitive_closure(graph<N, E> const& g, std::size_t threads = 0);
+// [[nodiscard]] auto reaches(N const& src, N const& dst) const -> bool;
+// [[nodiscard]] auto reachable_from(N const& src) const -> std::vector<N>;
+TEST_CASE("transitive closure of a DAG") {
+	auto g = gdwg::graph<std::string, int>{"a", "b", "c", "d", "e"};
+	g.insert_edge("a", "b", 1);
+	g.insert_edge("a", "b", 2);
+	g.insert_edge("b", "c", 1);
+	g.insert_edge("d", "c", 1);
+
+	auto const closure = gdwg::transitive_closure(g);
+	CHECK(closure.nodes() == g.nodes());
+	CHECK(closure.reaches("a", "c"));
+	CHECK(closure.reaches("d", "c"));
+	CHECK(closure.reaches("e", "e"));
+	CHECK_FALSE(closure.reaches("c", "a"));
+	CHECK_FALSE(closure.reaches("a", "d"));
+	CHECK(closure.reachable_from("a") == std::vector<std::string>{"a", "b", "c"});
+	CHECK(closure.reachable_from("e") == std::vector<std::string>{"e"});
+
+	// a snapshot
+	g.insert_edge("c", "e", 1);
+	CHECK_FALSE(closure.reaches("a", "e"));
+
+	CHECK_THROWS_WITH(closure.reaches("a", "z"),
+	                  "Cannot call gdwg::transitive_closure<N>::reaches on a node that doesn't "
+	                  "exist in the graph");
+	CHECK_THROWS_WITH(closure.reachable_from("z"),
+	                  "Cannot call gdwg::transitive_closure<N>::reachable_from on a node that "
+	                  "doesn't exist in the graph");
+
+	CHECK(gdwg::transitive_closure(gdwg::graph<int, int>{}).nodes().empty());
+}
+
+TEST_CASE("transitive closure rejects cycles") {
+	auto g = gdwg::graph<int, int>{1, 2, 3};
+	g.insert_edge(1, 2, 0);
+	g.insert_edge(2, 3, 0);
+	g.insert_edge(3, 1, 0);
+	CHECK_THROWS_WITH(gdwg::transitive_closure(g),
+	                  "Cannot compute gdwg::transitive_closure of a graph with a cycle");
+	auto self_loop = gdwg::graph<int, int>{1};
+	self_loop.insert_edge(1, 1, 0);
+	CHECK_THROWS_WITH(gdwg::transitive_closure(self_loop),
+	                  "Cannot compute gdwg::transitive_closure of a graph with a cycle");
+}
+
+// random DAGs (edges only go to larger nodes) against a depth first search from every node.
+// 5000 nodes is above the size where the rows are computed on several threads
+TEST_CASE("transitive closure matches a search from every node") {
+	auto const n = GENERATE(200, 5000);
+	auto engine = std::mt19937(6771);
+	auto g = gdwg::graph<int, int>{};
+	for (auto i = 0; i < n; ++i) {
+		g.insert_node(i);
+	}
+	auto offset = std::geometric_distribution<int>(0.05);
+	auto pick = std::uniform_int_distribution<int>(0, n - 1);
+	for (auto i = 0; i < 2 * n; ++i) {
+		auto const from = pick(engine);
+		auto const to = from + 1 + offset(engine);
+		if (to < n) {
+			g.insert_edge(from, to, 1);
+		}
+	}
+
+	auto const parallel = gdwg::transitive_closure(g, 4);
+	auto const sequential = gdwg::transitive_closure(g, 1);
+	auto sample = std::uniform_int_distribution<int>(0, n - 1);
+	for (auto i = 0; i < 20; ++i) {
+		auto const src = sample(engine);
+		auto seen = std::vector<bool>(static_cast<std::size_t>(n), false);
+		auto stack = std::vector<int>{src};
+		seen[static_cast<std::size_t>(src)] = true;
+		while (not stack.empty()) {
+			auto const u = stack.back();
+			stack.pop_back();
+			for (auto const v : g.connections(u)) {
+				if (not seen[static_cast<std::size_t>(v)]) {
+					seen[static_cast<std::size_t>(v)] = true;
+					stack.push_back(v);
+				}
+			}
+		}
+		auto expected = std::vector<int>{};
+		for (auto v = 0; v < n; ++v) {
+			if (seen[static_cast<std::size_t>(v)]) {
+				expected.push_back(v);
+			}
+			REQUIRE(parallel.reaches(src, v) == seen[static_cast<std::size_t>(v)]);
+		}
+		REQUIRE(parallel.reachable_from(src) == expected);
+		REQUIRE(sequential.reachable_from(src) == expected);
+	}
+}
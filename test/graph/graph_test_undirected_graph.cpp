@@ -0,0 +1,147 @@
+#include "gdwg/undirected_graph.hpp"
+#include <catch2/catch.hpp>
+#include <sstream>
+#include <string>
+#include <tuple>
+#include <vector>
+
+//-------------------------------------------------------------------------------------------------
+//                 test undirected_graph: every edge stored once, seen both ways
+//-------------------------------------------------------------------------------------------------
+
+static_assert(ranges::forward_iterator<gdwg::undirected_graph<int, int>::iterator>);
+static_assert(ranges::forward_range<gdwg::undirected_graph<int, int> const>);
+
+// all edges of the symmetric view, in iteration order
+template<typename N, typename E>
+auto all_edges(gdwg::undirected_graph<N, E> const& g) -> std::vector<std::tuple<N, N, E>> {
+	auto result = std::vector<std::tuple<N, N, E>>{};
+	for (auto const& [from, to, weight] : g) {
+		result.emplace_back(from, to, weight);
+	}
+	return result;
+}
+
+// constructors, insert_node, insert_edge and the accessors see both directions
+TEST_CASE("undirected_graph accessors") {
+	using graph = gdwg::undirected_graph<std::string, int>;
+	auto const v = std::vector<graph::value_type>{
+	   {"sydney", "perth", 5},
+	   {"perth", "sydney", 3},
+	   {"perth", "darwin", 1},
+	};
+	auto g = graph(v.begin(), v.end());
+	g.insert_node("hobart");
+
+	CHECK(g.nodes() == std::vector<std::string>{"darwin", "hobart", "perth", "sydney"});
+	CHECK(g.is_connected("sydney", "perth"));
+	CHECK(g.is_connected("perth", "sydney"));
+	CHECK(not g.is_connected("hobart", "perth"));
+	CHECK(g.weights("sydney", "perth") == std::vector<int>{3, 5});
+	CHECK(g.weights("perth", "sydney") == std::vector<int>{3, 5});
+	CHECK(g.connections("perth") == std::vector<std::string>{"darwin", "sydney"});
+	CHECK(g.connections("darwin") == std::vector<std::string>{"perth"});
+	CHECK(g.connections("hobart").empty());
+	CHECK(g.num_edges() == 3);
+	CHECK(not g.insert_edge("sydney", "perth", 3));
+	CHECK(not g.insert_edge("darwin", "perth", 1));
+
+	using edge = std::tuple<std::string, std::string, int>;
+	CHECK(*g.find("sydney", "perth", 3) == edge{"sydney", "perth", 3});
+	CHECK(*g.find("perth", "sydney", 3) == edge{"perth", "sydney", 3});
+	CHECK(g.find("perth", "darwin", 2) == g.end());
+	CHECK(all_edges(g)
+	      == std::vector<edge>{
+	         {"darwin", "perth", 1},
+	         {"perth", "darwin", 1},
+	         {"perth", "sydney", 3},
+	         {"perth", "sydney", 5},
+	         {"sydney", "perth", 3},
+	         {"sydney", "perth", 5},
+	      });
+	CHECK(++g.find("darwin", "perth", 1) == g.find("perth", "darwin", 1));
+
+	auto out = std::ostringstream{};
+	out << g;
+	CHECK(out.str()
+	      == "darwin (\n  perth | 1\n)\nhobart (\n)\nperth (\n  darwin | 1\n  sydney | 3\n"
+	         "  sydney | 5\n)\nsydney (\n  perth | 3\n  perth | 5\n)\n");
+
+	SECTION("exceptions") {
+		CHECK_THROWS_MATCHES(g.insert_edge("sydney", "adelaide", 1),
+		                     std::runtime_error,
+		                     Catch::Matchers::Message("Cannot call gdwg::undirected_graph<N, E>::"
+		                                              "insert_edge when either src or dst node does "
+		                                              "not exist"));
+		CHECK_THROWS_MATCHES(g.weights("adelaide", "sydney"),
+		                     std::runtime_error,
+		                     Catch::Matchers::Message("Cannot call gdwg::undirected_graph<N, E>::"
+		                                              "weights if src or dst node don't exist in the "
+		                                              "graph"));
+		CHECK_THROWS_AS(g.is_connected("adelaide", "sydney"), std::runtime_error);
+		CHECK_THROWS_AS(g.connections("adelaide"), std::runtime_error);
+		CHECK_THROWS_AS(g.erase_edge("adelaide", "sydney", 1), std::runtime_error);
+	}
+}
+
+// erase_node, erase_edge, replace_node, merge_replace_node keep both ends of every edge
+TEST_CASE("undirected_graph modifiers") {
+	using edge = std::tuple<int, int, int>;
+	auto g = gdwg::undirected_graph<int, int>{1, 2, 3, 4};
+	g.insert_edge(1, 1, 7);
+	g.insert_edge(2, 1, 5);
+	g.insert_edge(3, 1, 6);
+	g.insert_edge(3, 2, 6);
+	CHECK(g.num_edges() == 4);
+	CHECK(all_edges(g)
+	      == std::vector<edge>{
+	         {1, 1, 7},
+	         {1, 2, 5},
+	         {1, 3, 6},
+	         {2, 1, 5},
+	         {2, 3, 6},
+	         {3, 1, 6},
+	         {3, 2, 6},
+	      });
+
+	SECTION("erase") {
+		CHECK(g.erase_edge(2, 3, 6));
+		CHECK(not g.erase_edge(3, 2, 6));
+		CHECK(not g.is_connected(3, 2));
+		CHECK(g.connections(3) == std::vector<int>{1});
+		CHECK(g.erase_node(1));
+		CHECK(not g.erase_node(1));
+		CHECK(all_edges(g).empty());
+		CHECK(g.num_edges() == 0);
+		g.insert_node(1);
+		CHECK(g.connections(1).empty());
+		CHECK(g.connections(2).empty());
+	}
+	SECTION("merge replace merges duplicate edges") {
+		g.merge_replace_node(2, 3);
+		CHECK(all_edges(g)
+		      == std::vector<edge>{{1, 1, 7}, {1, 3, 5}, {1, 3, 6}, {3, 1, 5}, {3, 1, 6}, {3, 3, 6}});
+		CHECK(g.num_edges() == 4);
+		CHECK(not g.is_node(2));
+	}
+	SECTION("replace") {
+		CHECK(g.replace_node(1, 9));
+		CHECK(not g.replace_node(9, 2));
+		CHECK(g.weights(9, 2) == std::vector<int>{5});
+		CHECK(g.connections(9) == std::vector<int>{2, 3, 9});
+		CHECK(g.num_edges() == 4);
+	}
+	SECTION("comparison and clear") {
+		auto other = gdwg::undirected_graph<int, int>{1, 2, 3, 4};
+		other.insert_edge(1, 3, 6);
+		other.insert_edge(2, 3, 6);
+		other.insert_edge(1, 2, 5);
+		other.insert_edge(1, 1, 7);
+		CHECK(other == g);
+		other.erase_edge(1, 1, 7);
+		CHECK(other != g);
+		g.clear();
+		CHECK(g.empty());
+		CHECK(g.begin() == g.end());
+	}
+}
@@ -0,0 +1,116 @@
+#include "gdwg/unordered_graph.hpp"
+#include <algorithm>
+#include <catch2/catch.hpp>
+#include <string>
+#include <tuple>
+#include <vector>
+
+//-------------------------------------------------------------------------------------------------
+//                         test the hash based unordered_graph
+//-------------------------------------------------------------------------------------------------
+
+static_assert(ranges::forward_iterator<gdwg::unordered_graph<int, int>::iterator>);
+static_assert(ranges::forward_range<gdwg::unordered_graph<int, int> const>);
+
+// results of unordered_graph come in an unspecified order: sort them before comparing
+template<typename T>
+auto sorted(std::vector<T> v) -> std::vector<T> {
+	std::sort(v.begin(), v.end());
+	return v;
+}
+
+// all edges of the graph, sorted
+template<typename N, typename E>
+auto all_edges(gdwg::unordered_graph<N, E> const& g) -> std::vector<std::tuple<N, N, E>> {
+	auto result = std::vector<std::tuple<N, N, E>>{};
+	for (auto const& [from, to, weight] : g) {
+		result.emplace_back(from, to, weight);
+	}
+	return sorted(result);
+}
+
+// constructors, insert_node, insert_edge and the accessors
+TEST_CASE("unordered_graph accessors") {
+	using graph = gdwg::unordered_graph<std::string, int>;
+	auto const v = std::vector<graph::value_type>{
+	   {"sydney", "perth", 5},
+	   {"sydney", "perth", 3},
+	   {"perth", "darwin", 1},
+	};
+	auto g = graph(v.begin(), v.end());
+	g.insert_node("hobart");
+
+	CHECK(sorted(g.nodes()) == std::vector<std::string>{"darwin", "hobart", "perth", "sydney"});
+	CHECK(g.is_node("hobart"));
+	CHECK(not g.is_node("adelaide"));
+	CHECK(not g.insert_node("hobart"));
+	CHECK(g.is_connected("sydney", "perth"));
+	CHECK(not g.is_connected("perth", "sydney"));
+	CHECK(sorted(g.weights("sydney", "perth")) == std::vector<int>{3, 5});
+	CHECK(g.weights("hobart", "perth").empty());
+	CHECK(g.connections("sydney") == std::vector<std::string>{"perth"});
+	CHECK(g.num_edges() == 3);
+	CHECK(not g.insert_edge("sydney", "perth", 5));
+	CHECK(g.find("perth", "darwin", 1) != g.end());
+	CHECK(*g.find("perth", "darwin", 1)
+	      == std::tuple<std::string, std::string, int>{"perth", "darwin", 1});
+	CHECK(g.find("perth", "darwin", 2) == g.end());
+
+	SECTION("exceptions") {
+		CHECK_THROWS_MATCHES(g.insert_edge("sydney", "adelaide", 1),
+		                     std::runtime_error,
+		                     Catch::Matchers::Message("Cannot call gdwg::unordered_graph<N, E>::"
+		                                              "insert_edge when either src or dst node does "
+		                                              "not exist"));
+		CHECK_THROWS_AS(g.is_connected("adelaide", "sydney"), std::runtime_error);
+		CHECK_THROWS_AS(g.weights("adelaide", "sydney"), std::runtime_error);
+		CHECK_THROWS_AS(g.connections("adelaide"), std::runtime_error);
+		CHECK_THROWS_AS(g.erase_edge("adelaide", "sydney", 1), std::runtime_error);
+	}
+}
+
+// erase_node, erase_edge, replace_node, merge_replace_node keep both directions of the index
+TEST_CASE("unordered_graph modifiers") {
+	auto g = gdwg::unordered_graph<int, int>{1, 2, 3, 4};
+	g.insert_edge(1, 1, 7);
+	g.insert_edge(1, 2, 5);
+	g.insert_edge(2, 1, 5);
+	g.insert_edge(3, 1, 6);
+	g.insert_edge(3, 2, 6);
+
+	SECTION("erase") {
+		CHECK(g.erase_edge(3, 2, 6));
+		CHECK(not g.erase_edge(3, 2, 6));
+		CHECK(not g.is_connected(3, 2));
+		CHECK(g.erase_node(1));
+		CHECK(not g.erase_node(1));
+		CHECK(all_edges(g).empty());
+		CHECK(g.num_edges() == 0);
+		g.insert_node(1);
+		CHECK(g.connections(1).empty());
+	}
+	SECTION("merge replace merges duplicate edges") {
+		g.merge_replace_node(2, 3);
+		using edge = std::tuple<int, int, int>;
+		CHECK(all_edges(g)
+		      == std::vector<edge>{{1, 1, 7}, {1, 3, 5}, {3, 1, 5}, {3, 1, 6}, {3, 3, 6}});
+		CHECK(g.num_edges() == 5);
+		CHECK(not g.is_node(2));
+	}
+	SECTION("replace") {
+		CHECK(g.replace_node(1, 9));
+		CHECK(not g.replace_node(9, 2));
+		using edge = std::tuple<int, int, int>;
+		CHECK(all_edges(g)
+		      == std::vector<edge>{{2, 9, 5}, {3, 2, 6}, {3, 9, 6}, {9, 2, 5}, {9, 9, 7}});
+	}
+	SECTION("comparison and clear") {
+		auto copy = g;
+		CHECK(copy == g);
+		copy.erase_edge(1, 1, 7);
+		CHECK(copy != g);
+		g.clear();
+		CHECK(g.empty());
+		CHECK(g.begin() == g.end());
+	}
+}